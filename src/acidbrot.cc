@@ -1,16 +1,18 @@
 #include "glfw_wrapper.hh"
 #include "acidbrot_app.hh"
 
+#include "fractal/cpu_bench.hh"
+#include "fractal/big_float_bench.hh"
+
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <string>
+
 // ============================================================================
 
 int main (int argc, char* argv[]) {
 
-    (void)argc;
-    (void)argv;
-    
     spdlog::set_pattern("%n: %^%v%$");
     spdlog::set_level(spdlog::level::debug);
 
@@ -21,7 +23,17 @@ int main (int argc, char* argv[]) {
 
     int  exitCode = 0;
 
+    // Run a benchmark instead of the app
+    std::string arg = (argc > 1) ? argv[1] : "";
+
     try {
+        if (arg == "--bench") {
+            return runCpuBenchmark(logger);
+        }
+        if (arg == "--bench-bigfloat") {
+            return runBigFloatBenchmark(logger);
+        }
+
         // Initialize GLFW
         auto glfw = GLFWWrapper::getInstance();
 
@@ -88,41 +88,91 @@ int AcidbrotApp::initialize () {
     m_HaveFp64 = GL::isExtensionAvailable("GL_ARB_gpu_shader_fp64");
     m_Logger->info("m_HaveFp64 {}", m_HaveFp64);
 
+    // Compute shaders and storage buffers are core since OpenGL 4.3
+    m_HaveCompute = (GLVersion.major > 4) || (GLVersion.major == 4 && GLVersion.minor >= 3);
+    m_Logger->info("m_HaveCompute {}", m_HaveCompute);
+
     // ..........................................
 
     m_ScreenQuad.reset(new GL::ScreenQuad());
+    m_FractalTimer.reset(new GL::TimerQuery());
 
     // ..........................................
 
-    m_Fonts["generic"] = std::unique_ptr<GL::Font>(new GL::Font("media/fonts/Roboto-Regular.ttf"));
+    m_CpuRenderer.reset(new CpuRenderer());
+    m_Logger->info("CPU renderer: {}, {} threads",
+        getCpuIsaName(m_CpuRenderer->getIsa()),
+        m_CpuRenderer->getThreadCount()
+        );
+
+    m_TileCache.reset(new TileCache(TileCacheBudget, TileCacheDir, m_CpuRenderer->getIsa()));
 
     // ..........................................
 
-    std::string mandelbrotShader = (m_HaveFp64) ? "shaders/mandelbrot64.fsh" :
-                                                  "shaders/mandelbrot32.fsh";
+    m_Fonts["generic"] = std::unique_ptr<GL::Font>(new GL::Font("media/fonts/Roboto-Regular.ttf"));
+
+    // ..........................................
 
     GL::Shader vshGeneric      ("shaders/generic2d.vsh", GL_VERTEX_SHADER);
-    GL::Shader fshMandelbrot   (mandelbrotShader,        GL_FRAGMENT_SHADER, {{"MANDELBROT", "1"}});
-    GL::Shader fshJulia        (mandelbrotShader,        GL_FRAGMENT_SHADER, {{"JULIA", "1"}});
+
+    GL::Shader fshMirror       ("shaders/mirror.fsh",    GL_FRAGMENT_SHADER);
     GL::Shader fshColorizer    ("shaders/colorizer.fsh", GL_FRAGMENT_SHADER);
-    GL::Shader fshDespeckle    ("shaders/despeckle.fsh", GL_FRAGMENT_SHADER, {{"MAX_TAPS", "25"}});
-    GL::Shader fshHaloMask     ("shaders/haloMask.fsh",  GL_FRAGMENT_SHADER, {{"MAX_TAPS", "25"}});
+    std::string maxTaps = std::to_string(MaxFilterTaps);
+
+    GL::Shader fshDespeckle    ("shaders/despeckle.fsh", GL_FRAGMENT_SHADER, {{"MAX_TAPS", maxTaps}});
+    GL::Shader fshHaloMask     ("shaders/haloMask.fsh",  GL_FRAGMENT_SHADER, {{"MAX_TAPS", maxTaps}});
+    GL::Shader fshHaloMaskCol  ("shaders/haloMask.fsh",  GL_FRAGMENT_SHADER, {{"MAX_TAPS", maxTaps}, {"COLORIZE", "1"}});
+    GL::Shader fshFir          ("shaders/fir.fsh",       GL_FRAGMENT_SHADER, {{"MAX_TAPS", maxTaps}});
     GL::Shader fshHalo         ("shaders/halo.fsh",      GL_FRAGMENT_SHADER);
     GL::Shader fshNoiseDispl   ("shaders/noise_displacement.fsh", GL_FRAGMENT_SHADER);
+    GL::Shader fshHaloNoise    ("shaders/noise_displacement.fsh", GL_FRAGMENT_SHADER, {{"HALO", "1"}});
     GL::Shader fshColorConv    ("shaders/color_conv_mrt.fsh",     GL_FRAGMENT_SHADER);
 
     m_Shaders["font"]       = std::unique_ptr<GL::ShaderProgram>(new GL::GenericFontShader());
 
-    m_Shaders["mandelbrot"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
-        vshGeneric,
-        fshMandelbrot,
-        "mandelbrot"
-        ));
+    // Fractal shader variants, compiled on first use. Without fp64 support
+    // it is emulated with pairs of floats. Fixed point is CPU only, the CPU
+    // has no double-float kernel.
+    m_Ladder.setAvailable(FractalPrecision::Fp64, m_HaveFp64);
+    m_Ladder.setAvailable(FractalPrecision::Fixed128, false);
+    m_CpuLadder.setAvailable(FractalPrecision::DoubleFloat, false);
+
+    m_FractalShaders.reset(new FractalShaderCache("shaders/generic2d.vsh", FractalShaderCacheSize));
+    m_FractalShaders->setSource(FractalPrecision::Fp32,        "shaders/mandelbrot32.fsh");
+    m_FractalShaders->setSource(FractalPrecision::DoubleFloat, "shaders/mandelbrot_df.fsh");
+
+    if (m_HaveFp64) {
+        m_FractalShaders->setSource(FractalPrecision::Fp64, "shaders/mandelbrot64.fsh");
+    }
+
+    m_FractalShaders->setSource(FractalPrecision::Perturbation, "shaders/mandelbrot_perturb.fsh", {
+        {"ORBIT_WIDTH",      std::to_string(OrbitTextureWidth)},
+        {"BLA_WIDTH",        std::to_string(BlaTextureWidth)},
+        {"MAX_BLA_LEVELS",   std::to_string(MaxBlaLevels)},
+        {"MAX_SERIES_TERMS", std::to_string(SeriesApprox::MAX_TERMS)}
+    });
+
+    // Compute shader fractal engine, fp32 only
+    if (m_HaveCompute) {
+        const std::string computeShader = "shaders/mandelbrot_compute.csh";
+        GL::Shader cshMandelbrot (computeShader, GL_COMPUTE_SHADER, {{"MANDELBROT", "1"}});
+        GL::Shader cshJulia      (computeShader, GL_COMPUTE_SHADER, {{"JULIA", "1"}});
+
+        m_Shaders["mandelbrotCompute"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+            cshMandelbrot,
+            "mandelbrotCompute"
+            ));
+
+        m_Shaders["juliaCompute"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+            cshJulia,
+            "juliaCompute"
+            ));
+    }
 
-    m_Shaders["julia"]      = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+    m_Shaders["mirror"]     = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
         vshGeneric,
-        fshJulia,
-        "julia"
+        fshMirror,
+        "mirror"
         ));
 
     m_Shaders["despeckle"]  = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
@@ -149,12 +199,31 @@ int AcidbrotApp::initialize () {
         "halo"
         ));
 
+    m_Shaders["fir"]        = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+        vshGeneric,
+        fshFir,
+        "fir"
+        ));
+
     m_Shaders["noise_displacement"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
         vshGeneric,
         fshNoiseDispl,
         "noise_displacement"
         ));
 
+    // Fused post-processing passes
+    m_Shaders["haloMaskColorize"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+        vshGeneric,
+        fshHaloMaskCol,
+        "haloMaskColorize"
+        ));
+
+    m_Shaders["haloNoiseDisplacement"] = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
+        vshGeneric,
+        fshHaloNoise,
+        "haloNoiseDisplacement"
+        ));
+
     m_Shaders["colorConv"]  = std::unique_ptr<GL::ShaderProgram>(new GL::ShaderProgram(
         vshGeneric,
         fshColorConv,
@@ -178,7 +247,8 @@ int AcidbrotApp::initialize () {
         m_Parameters.insert({a_Parameter.name, a_Parameter});
     };
 
-    addParameter(Parameter("fractalIter", true,  256.0,  10.0, 512.0, 100.000));
+    addParameter(Parameter("fractalIter", true,  256.0,  10.0, 4096.0, 400.000));
+    addParameter(Parameter("fractalSeries", false, 8.0,  0.0,  16.0,  4.000));
     addParameter(Parameter("colorExp",    true,  1.0000, 0.5,  2.0,   0.500));
     addParameter(Parameter("colorCycles", true,  4.0000, 1.0,  6.0,   1.000));
     addParameter(Parameter("haloSteps",   false, 15.0,   10.0, 50.0,  20.0));
@@ -209,6 +279,23 @@ int AcidbrotApp::initialize () {
     mask->normalizeWeights();
     m_Masks["edges"].reset(mask);
 
+    // A Gaussian, separable. Its passes take 8 bilinear fetches each instead
+    // of 225 dense ones.
+    mask = new FilterMask(15, 15);
+    {
+        std::vector<float> weights;
+        for (int j=-7; j<=+7; ++j) {
+            for (int i=-7; i<=+7; ++i) {
+                weights.push_back(expf(-float(i*i + j*j) / (2.0f * 3.0f * 3.0f)));
+            }
+        }
+        mask->setWeights(weights);
+    }
+    mask->normalizeWeights();
+    mask->setSeparable(true);
+    mask->setBilinearFolding(true);
+    m_Masks["haloBlur"].reset(mask);
+
     // ..........................................
 
     m_Textures["colormap"] = std::unique_ptr<GL::Texture>(
@@ -221,6 +308,8 @@ int AcidbrotApp::initialize () {
 
     // ..........................................
 
+    initializeRenderGraph();
+
     int res = initializeFramebuffers();
     if (res) {
         return res;
@@ -237,9 +326,17 @@ int AcidbrotApp::initialize () {
 
     m_Viewport.position.zoom = -1.0f;
 
+    m_Center[0] = m_Viewport.position.position[0];
+    m_Center[1] = m_Viewport.position.position[1];
+
     m_Viewport.position.julia[0] = 0.7885f;
     m_Viewport.position.julia[1] = 0.0f;
 
+    // ..........................................
+
+    // Measure relative costs of fractal precisions
+    benchmarkFractalShaders();
+
     // ..........................................
     
     // Timers
@@ -248,44 +345,55 @@ int AcidbrotApp::initialize () {
     return 0;
 }
 
-int AcidbrotApp::initializeFramebuffers () {
+int AcidbrotApp::initializeFractalFramebuffers () {
 
-    // Get the main framebuffer size
+    // The fractal field is scaled relative to the main framebuffer
     int fbWidth, fbHeight;
     glfwGetFramebufferSize(m_Window, &fbWidth, &fbHeight);
 
-    m_Logger->info("Framebuffer size ({}, {})", fbWidth, fbHeight);
+    double scale  = m_Governor.getScale();
+    size_t width  = std::max<size_t>(1, size_t(round(fbWidth  * scale)));
+    size_t height = std::max<size_t>(1, size_t(round(fbHeight * scale)));
 
-    // ..........................................
+    // Fractal fields with reprojection errors and optionally states. The
+    // previous field is kept for reprojection. Iteration counts are stored
+    // as floats (see iter.fsh).
+    std::vector<GLenum> fractalFormats = {GL_R32F, GL_RG16F};
+    if (m_UseResume) {
+        fractalFormats.push_back(GL_RGBA32F);
+    }
 
     m_Framebuffers["fractalRaw"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
+        new GL::Framebuffer(width, height, fractalFormats, false)
     );
 
-    m_Framebuffers["fractalFlt"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
+    m_Framebuffers["fractalPrev"] = std::unique_ptr<GL::Framebuffer>(
+        new GL::Framebuffer(width, height, fractalFormats, false)
     );
 
-    m_Framebuffers["fractalColor"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
+    m_Framebuffers["fractalHalf"] = std::unique_ptr<GL::Framebuffer>(
+        new GL::Framebuffer(width, height, fractalFormats, false)
     );
 
-    m_Framebuffers["haloMask"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
-    );
+    m_ReprojView.valid = false;
+    m_Progress.reset();
 
-    m_Framebuffers["preScreenFx"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
-    );
+    return 0;
+}
 
+int AcidbrotApp::initializeFramebuffers () {
 
-    m_Framebuffers["master"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RGBA, 1, false)
-    );
+    // Get the main framebuffer size
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(m_Window, &fbWidth, &fbHeight);
 
-    m_Framebuffers["masterYUV"] = std::unique_ptr<GL::Framebuffer>(
-        new GL::Framebuffer(fbWidth, fbHeight, GL_RED,  3, false)
-    );
+    m_Logger->info("Framebuffer size ({}, {})", fbWidth, fbHeight);
+
+    // ..........................................
+
+    initializeFractalFramebuffers();
+
+    m_RenderGraph.resize(fbWidth, fbHeight);
 
     // ..........................................
 
@@ -296,6 +404,207 @@ int AcidbrotApp::initializeFramebuffers () {
     return 0;
 }
 
+void AcidbrotApp::initializeRenderGraph () {
+
+    m_RenderGraph.clear();
+
+    // Full resolution targets. "master" keeps the previous frame for motion
+    // blur and is displayed, "masterYUV" is read for video recording. Fused
+    // passes write the color and the halo mask together and need no
+    // intermediate for the halo.
+    m_RenderGraph.addTarget("fractalFlt",   {GL_R32F});
+
+    if (m_FusedPostFx) {
+        m_RenderGraph.addTarget("fractalColorMask", {GL_RGBA, GL_RGBA});
+    }
+    else {
+        m_RenderGraph.addTarget("fractalColor", {GL_RGBA});
+        m_RenderGraph.addTarget("haloMask",     {GL_RGBA});
+        m_RenderGraph.addTarget("preScreenFx",  {GL_RGBA});
+    }
+
+    if (m_HaloBlur) {
+        m_RenderGraph.addTarget("haloMaskBlur", {GL_RGBA});
+    }
+
+    m_RenderGraph.addTarget("master",       {GL_RGBA});
+    m_RenderGraph.addTarget("masterYUV",    {GL_RED, GL_RED, GL_RED});
+
+    m_RenderGraph.setOutput("master");
+
+    typedef GL::RenderGraph::Input Input;
+
+    GLuint colormap = m_Textures.at("colormap")->get();
+    GLuint noise    = m_Textures3d.at("noise")->get();
+
+    // Blends a pass over the previous frame
+    auto drawMotionBlur = [this]() {
+        GL_CHECK(glEnable(GL_BLEND));
+        GL_CHECK(glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD));
+        GL_CHECK(glBlendFuncSeparate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA, GL_ONE, GL_ZERO));
+        GL_CHECK(glBlendColor(0.0f, 0.0f, 0.0f, m_Parameters.at("motionBlur").value));
+
+        m_ScreenQuad->drawFullscreen();
+
+        GL_CHECK(glDisable(GL_BLEND));
+    };
+
+    // ................................
+    // Filter the fractal. The shader mirrors coordinates out of the field
+    // itself.
+    GL::ShaderProgram* despeckle = m_Shaders.at("despeckle").get();
+    m_RenderGraph.addPass("despeckle", despeckle,
+        {Input("fractalField")},
+        "fractalFlt",
+        [this, despeckle]() {
+            setFilterUniforms(despeckle, "despeckle");
+            m_ScreenQuad->drawFullscreen();
+        });
+
+    if (m_FusedPostFx) {
+
+        // ................................
+        // Colorize the fractal and create the halo effect mask. The edge
+        // filter needs the filtered field around a pixel, so the filtering
+        // stays a pass of its own.
+        GL::ShaderProgram* colorMask = m_Shaders.at("haloMaskColorize").get();
+        m_RenderGraph.addPass("haloMaskColorize", colorMask,
+            {Input("fractalFlt", "fractalIter", GL_MIRRORED_REPEAT),
+             Input(GL_TEXTURE_2D, colormap, "colormap", GL_MIRRORED_REPEAT)},
+            "fractalColorMask",
+            [this, colorMask]() {
+                GL_CHECK(glUniform1f(colorMask->getUniformLocation("colormapPos"), m_Viewport.position.color));
+                setUniforms();
+                setFilterUniforms(colorMask, "edges");
+
+                m_ScreenQuad->drawFullscreen();
+            });
+
+        // ................................
+        // Blur the halo effect mask
+        Input haloMask ("fractalColorMask", "haloMask", 0, 1);
+        if (m_HaloBlur) {
+            addFilterPasses("haloBlur", "haloBlur",
+                Input("fractalColorMask", "", GL_MIRRORED_REPEAT, 1),
+                "haloMaskBlur");
+            haloMask = Input("haloMaskBlur", "haloMask");
+        }
+
+        // ................................
+        // Add the halo effect and the noise displacement, blended over the
+        // previous frame
+        GL::ShaderProgram* haloNoise = m_Shaders.at("haloNoiseDisplacement").get();
+        m_RenderGraph.addPass("haloNoiseDisplacement", haloNoise,
+            {Input("fractalColorMask", "color",    0, 0),
+             haloMask,
+             Input(GL_TEXTURE_3D, noise, "noise")},
+            "master",
+            [this, haloNoise, drawMotionBlur]() {
+                setUniforms();
+
+                GL_CHECK(glUniform1i(haloNoise->getUniformLocation("haloSteps"),
+                            int(m_Parameters.at("haloSteps").value)
+                            ));
+                GL_CHECK(glUniform1f(haloNoise->getUniformLocation("time"), m_Timers.at("weave")));
+
+                drawMotionBlur();
+            });
+    }
+    else {
+
+        // ................................
+        // Colorize the fractal
+        GL::ShaderProgram* colorizer = m_Shaders.at("colorizer").get();
+        m_RenderGraph.addPass("colorizer", colorizer,
+            {Input("fractalFlt", "fractal"),
+             Input(GL_TEXTURE_2D, colormap, "colormap", GL_MIRRORED_REPEAT)},
+            "fractalColor",
+            [this, colorizer]() {
+                GL_CHECK(glUniform1f(colorizer->getUniformLocation("colormapPos"), m_Viewport.position.color));
+                setUniforms();
+
+                m_ScreenQuad->drawFullscreen();
+            });
+
+        // ................................
+        // Create the halo effect mask
+        GL::ShaderProgram* haloMask = m_Shaders.at("haloMask").get();
+        m_RenderGraph.addPass("haloMask", haloMask,
+            {Input("fractalFlt",   "fractalIter",  GL_MIRRORED_REPEAT),
+             Input("fractalColor", "fractalColor", GL_MIRRORED_REPEAT)},
+            "haloMask",
+            [this, haloMask]() {
+                setFilterUniforms(haloMask, "edges");
+                m_ScreenQuad->drawFullscreen();
+            });
+
+        // ................................
+        // Blur the halo effect mask
+        std::string haloTarget = "haloMask";
+        if (m_HaloBlur) {
+            addFilterPasses("haloBlur", "haloBlur",
+                Input("haloMask", "", GL_MIRRORED_REPEAT),
+                "haloMaskBlur");
+            haloTarget = "haloMaskBlur";
+        }
+
+        // ................................
+        // Add the halo effect
+        GL::ShaderProgram* halo = m_Shaders.at("halo").get();
+        m_RenderGraph.addPass("halo", halo,
+            {Input("fractalColor", "texture"),
+             Input(haloTarget,     "haloMask")},
+            "preScreenFx",
+            [this, halo]() {
+                setUniforms();
+
+                GL_CHECK(glUniform1i(halo->getUniformLocation("haloSteps"),
+                            int(m_Parameters.at("haloSteps").value)
+                            ));
+
+                m_ScreenQuad->drawFullscreen();
+            });
+
+        // ................................
+        // Noise displacement, blended over the previous frame
+        GL::ShaderProgram* noiseDispl = m_Shaders.at("noise_displacement").get();
+        m_RenderGraph.addPass("noise_displacement", noiseDispl,
+            {Input("preScreenFx", "color", GL_MIRRORED_REPEAT),
+             Input(GL_TEXTURE_3D, noise, "noise")},
+            "master",
+            [this, noiseDispl, drawMotionBlur]() {
+                setUniforms();
+
+                GL_CHECK(glUniform1f(noiseDispl->getUniformLocation("time"), m_Timers.at("weave")));
+
+                drawMotionBlur();
+            });
+    }
+
+    // ................................
+    // Convert "master" to "masterYUV", runs only while it is an output
+    GL::ShaderProgram* colorConv = m_Shaders.at("colorConv").get();
+    m_RenderGraph.addPass("colorConv", colorConv,
+        {Input("master")},
+        "masterYUV",
+        [this, colorConv]() {
+
+            // BT.709
+            // https://en.wikipedia.org/wiki/YUV
+            float matConv[] = {
+                 0.21260, 0.71520,  0.07220,
+                -0.09991,-0.33609,  0.43600,
+                 0.61500,-0.55861, -0.05639
+            };
+
+            GL_CHECK(glUniformMatrix3fv(colorConv->getUniformLocation("matConv"), 1, GL_TRUE, matConv));
+
+            // Render (flipped)
+            m_ScreenQuad->draw(-1.0f, -1.0f, +1.0f, +1.0f,
+                                0.0f,  1.0f,  1.0f,  0.0f);
+        });
+}
+
 void AcidbrotApp::setUniforms () {
 
     // Get current shader
@@ -321,6 +630,86 @@ void AcidbrotApp::setUniforms () {
     }
 }
 
+void AcidbrotApp::setFilterUniforms (GL::ShaderProgram* a_Shader, const std::string& a_Mask) {
+
+    FilterMask* mask = m_Masks.at(a_Mask).get();
+
+    // The shader would apply the first pass only
+    if (mask->getPassCount() != 1) {
+        throw std::runtime_error(
+            stringf("Filter mask '%s' has %zu passes, the shader takes one",
+                    a_Mask.c_str(), mask->getPassCount())
+        );
+    }
+
+    setFilterUniforms(a_Shader, mask, 0);
+}
+
+void AcidbrotApp::setFilterUniforms (GL::ShaderProgram* a_Shader, FilterMask* a_Mask, size_t a_Pass) {
+
+    size_t count = a_Mask->getCountForShader(a_Pass);
+    if (count > MaxFilterTaps) {
+        throw std::runtime_error(
+            stringf("Filter mask pass has %zu taps, the shaders take up to %zu",
+                    count, MaxFilterTaps)
+        );
+    }
+
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("filterTaps"),
+                count
+                ));
+    GL_CHECK(glUniform1fv(a_Shader->getUniformLocation("filterWeights"),
+                count,
+                a_Mask->getWeightsForShader(a_Pass)
+                ));
+    GL_CHECK(glUniform2fv(a_Shader->getUniformLocation("filterOffsets"),
+                count,
+                a_Mask->getOffsetsForShader(a_Pass)
+                ));
+}
+
+void AcidbrotApp::addFilterPasses (const std::string& a_Name,
+                                   const std::string& a_Mask,
+                                   const GL::RenderGraph::Input& a_Input,
+                                   const std::string& a_Output)
+{
+    typedef GL::RenderGraph::Input Input;
+
+    GL::ShaderProgram* fir  = m_Shaders.at("fir").get();
+    FilterMask*        mask = m_Masks.at(a_Mask).get();
+
+    Input input   = a_Input;
+    input.sampler = "texture";
+
+    // Dense, a single pass
+    if (mask->getPassCount() == 1) {
+        m_RenderGraph.addPass(a_Name, fir, {input}, a_Output,
+            [this, fir, mask]() {
+                setFilterUniforms(fir, mask, 0);
+                m_ScreenQuad->drawFullscreen();
+            });
+        return;
+    }
+
+    // Separable, horizontal then vertical. The intermediate target keeps
+    // the partial sums in half floats, bilinear fetches of the vertical
+    // pass need it linearly filtered which the targets are.
+    std::string intermediate = a_Name + "Rows";
+    m_RenderGraph.addTarget(intermediate, {GL_RGBA16F});
+
+    m_RenderGraph.addPass(a_Name + "H", fir, {input}, intermediate,
+        [this, fir, mask]() {
+            setFilterUniforms(fir, mask, 0);
+            m_ScreenQuad->drawFullscreen();
+        });
+
+    m_RenderGraph.addPass(a_Name + "V", fir, {Input(intermediate, "texture", input.wrap)}, a_Output,
+        [this, fir, mask]() {
+            setFilterUniforms(fir, mask, 1);
+            m_ScreenQuad->drawFullscreen();
+        });
+}
+
 // ============================================================================
 #define MAX_FILE_INDEX 9999
 
@@ -354,7 +743,7 @@ void AcidbrotApp::takeScreenshot () {
     const std::string nameFormat = "screenshot_%04d.png";
 
     // Download the framebuffer
-    GL::Framebuffer* fb = m_Framebuffers.at("master").get();
+    GL::Framebuffer* fb = m_RenderGraph.getTarget("master");
     auto data = fb->readPixels();
 
     // Determine file name
@@ -383,7 +772,7 @@ void AcidbrotApp::startRecording () {
     ParamDict encoderParams;
 
     // Initialize the video encoder
-    GL::Framebuffer* fb = m_Framebuffers.at("master").get();
+    GL::Framebuffer* fb = m_RenderGraph.getTarget("master");
     m_VideoRec.encoder.reset(new VideoEncoder(
                 fb->getWidth(),
                 fb->getHeight(),
@@ -428,7 +817,7 @@ void AcidbrotApp::recordFrame () {
     // and pass it to the video encoder
 
     // Download the framebuffer
-    GL::Framebuffer* fb = m_Framebuffers.at("masterYUV").get();
+    GL::Framebuffer* fb = m_RenderGraph.getTarget("masterYUV");
     auto dataY = fb->readPixels(0);
     auto dataU = fb->readPixels(1);
     auto dataV = fb->readPixels(2);
@@ -543,6 +932,139 @@ void AcidbrotApp::keyCallback(GLFWwindow* a_Window,
         }
     }
 
+    // Switch deep zoom mode
+    if (a_Key == GLFW_KEY_P && a_Action == GLFW_PRESS) {
+        m_DeepZoom = !m_DeepZoom;
+        m_Reference.valid = false;
+        m_Logger->info("Deep zoom {}", m_DeepZoom ? "on" : "off");
+    }
+
+    // Switch automatic fractal precision selection
+    if (a_Key == GLFW_KEY_K && a_Action == GLFW_PRESS) {
+        m_AutoPrecision = !m_AutoPrecision;
+        m_Logger->info("Automatic fractal precision {}", m_AutoPrecision ? "on" : "off");
+    }
+
+    // Switch fractal interior checks
+    if ((a_Key == GLFW_KEY_4 || a_Key == GLFW_KEY_5 || a_Key == GLFW_KEY_6) && a_Action == GLFW_PRESS) {
+        static const std::map<int, std::pair<unsigned, const char*>> checks = {
+            {GLFW_KEY_4, {INTERIOR_BULBS,       "cardioid/bulb"}},
+            {GLFW_KEY_5, {INTERIOR_PERIODICITY, "periodicity"}},
+            {GLFW_KEY_6, {INTERIOR_DERIVATIVE,  "derivative"}},
+        };
+
+        const auto& check = checks.at(a_Key);
+        m_InteriorChecks ^= check.first;
+        m_Logger->info("Interior {} check {}", check.second,
+            (m_InteriorChecks & check.first) ? "on" : "off");
+    }
+
+    // Switch temporal reprojection
+    if (a_Key == GLFW_KEY_T && a_Action == GLFW_PRESS) {
+        m_UseReprojection = !m_UseReprojection;
+        m_Logger->info("Temporal reprojection {}", m_UseReprojection ? "on" : "off");
+    }
+
+    // Switch progressive fractal rendering
+    if (a_Key == GLFW_KEY_O && a_Action == GLFW_PRESS) {
+        m_Progressive = !m_Progressive;
+        m_Logger->info("Progressive rendering {}", m_Progressive ? "on" : "off");
+    }
+
+    // Switch resumable fractal states. They live in the fractal fields.
+    if (a_Key == GLFW_KEY_I && a_Action == GLFW_PRESS) {
+        m_UseResume = !m_UseResume;
+        m_Logger->info("Resumable iteration states {}", m_UseResume ? "on" : "off");
+        initializeFractalFramebuffers();
+    }
+
+    // Switch dynamic fractal resolution
+    if (a_Key == GLFW_KEY_G && a_Action == GLFW_PRESS) {
+        m_UseGovernor = !m_UseGovernor;
+        m_Logger->info("Dynamic fractal resolution {}", m_UseGovernor ? "on" : "off");
+
+        if (!m_UseGovernor && m_Governor.reset()) {
+            initializeFractalFramebuffers();
+        }
+    }
+
+    // Switch symmetry
+    if (a_Key == GLFW_KEY_M && a_Action == GLFW_PRESS) {
+        m_UseSymmetry = !m_UseSymmetry;
+        m_Logger->info("Fractal symmetry {}", m_UseSymmetry ? "on" : "off");
+    }
+
+    // Switch between GPU and CPU rendering
+    if (a_Key == GLFW_KEY_R && a_Action == GLFW_PRESS) {
+        m_CpuRender = !m_CpuRender;
+        m_Logger->info("Rendering fractal on the {}", m_CpuRender ? "CPU" : "GPU");
+    }
+
+    // Change the fractal exponent
+    if (a_Key == GLFW_KEY_X && a_Action == GLFW_PRESS) {
+        m_Exponent = (m_Exponent < FractalVariant::MAX_EXPONENT) ? m_Exponent + 1 :
+                                                                   FractalVariant::MIN_EXPONENT;
+        m_Logger->info("Fractal exponent {}", m_Exponent);
+    }
+
+    // Change the fractal iterations per shader loop pass
+    if (a_Key == GLFW_KEY_V && a_Action == GLFW_PRESS) {
+        m_Unroll = (m_Unroll < 8) ? m_Unroll * 2 : 1;
+        m_Logger->info("Fractal shader unrolling {}x", m_Unroll);
+    }
+
+    // Switch the compute shader fractal engine
+    if (a_Key == GLFW_KEY_N && a_Action == GLFW_PRESS) {
+        m_UseCompute = !m_UseCompute;
+        m_Logger->info("Compute shader fractal engine {}{}", m_UseCompute ? "on" : "off",
+            m_HaveCompute ? "" : " (not available)");
+    }
+
+    // Switch the tile cache of the CPU renderer
+    if (a_Key == GLFW_KEY_H && a_Action == GLFW_PRESS) {
+        m_UseTileCache = !m_UseTileCache;
+        m_Logger->info("CPU fractal tile cache {}", m_UseTileCache ? "on" : "off");
+    }
+
+    // Switch subdivision of the CPU renderer
+    if (a_Key == GLFW_KEY_U && a_Action == GLFW_PRESS) {
+        m_CpuRenderer->setSubdivide(!m_CpuRenderer->getSubdivide());
+        m_Logger->info("CPU subdivision {}", m_CpuRenderer->getSubdivide() ? "on" : "off");
+    }
+
+    // Cycle SIMD lane refill of the CPU renderer, automatic, off and on
+    if (a_Key == GLFW_KEY_L && a_Action == GLFW_PRESS) {
+        switch (m_CpuRenderer->getRefill()) {
+        case CpuRefill::Auto: m_CpuRenderer->setRefill(CpuRefill::Off);  break;
+        case CpuRefill::Off:  m_CpuRenderer->setRefill(CpuRefill::On);   break;
+        case CpuRefill::On:   m_CpuRenderer->setRefill(CpuRefill::Auto); break;
+        }
+
+        const CpuRefill refill = m_CpuRenderer->getRefill();
+        m_Logger->info("CPU lane refill {}", (refill == CpuRefill::Auto) ? "automatic" :
+                                             (refill == CpuRefill::On)   ? "on" : "off");
+    }
+
+    // Switch fused post-processing passes
+    if (a_Key == GLFW_KEY_J && a_Action == GLFW_PRESS) {
+        m_FusedPostFx = !m_FusedPostFx;
+        initializeRenderGraph();
+        m_Logger->info("Fused post-processing {}", m_FusedPostFx ? "on" : "off");
+    }
+
+    // Switch the halo effect mask blur
+    if (a_Key == GLFW_KEY_Y && a_Action == GLFW_PRESS) {
+        m_HaloBlur = !m_HaloBlur;
+        initializeRenderGraph();
+        m_Logger->info("Halo mask blur {}", m_HaloBlur ? "on" : "off");
+    }
+
+    // Switch between series approximation and BLA
+    if (a_Key == GLFW_KEY_B && a_Action == GLFW_PRESS) {
+        m_UseBla = !m_UseBla;
+        m_Logger->info("Deep zoom iteration skipping using {}", m_UseBla ? "BLA" : "series approximation");
+    }
+
     // Switch modified parameter
     if (a_Key == GLFW_KEY_HOME && a_Action == GLFW_PRESS) {
         if (m_CurrParam == m_Parameters.end()) {
@@ -662,10 +1184,8 @@ int AcidbrotApp::updateScene (double dt) {
     {
         const double k = 0.90;
 
-        // More zoom -> slower lateral motion
-        float zoom = powf(2.0, m_Viewport.position.zoom);
-        control.position[0] /= zoom;
-        control.position[1] /= zoom;
+        // Lateral motion is in screen units, it gets scaled by the zoom
+        // when moving the extended precision position below
 
         // Rotate lateral motion vector
         float s = sinf(m_Viewport.position.rotation);
@@ -700,8 +1220,35 @@ int AcidbrotApp::updateScene (double dt) {
             m_Viewport.position.param[i] += m_Viewport.velocity.param[i] * dt;
         }
 
-        // Zooming more makes no sense due to precision
-        double maxZoom = (m_HaveFp64) ? 44.0f : 15.0f;
+        // Move the extended precision position, its precision follows the
+        // zoom. More zoom -> slower lateral motion, the whole powers of two
+        // of the scale are applied exactly so that it holds at any depth.
+        double whole      = floor(m_Viewport.position.zoom);
+        double fraction   = pow(2.0, whole - m_Viewport.position.zoom);
+        size_t centerBits = getCenterBits();
+        for (size_t i=0; i<2; ++i) {
+            BigFloat step = BigFloat(m_Viewport.velocity.position[i] * dt * fraction);
+            m_Center[i] = m_Center[i] + ldexp(step, -int64_t(whole));
+            m_Center[i].setBits(centerBits);
+            m_Viewport.position.position[i] = double(m_Center[i]);
+        }
+
+        // Zooming more makes no sense due to precision. Perturbation keeps
+        // pixel offsets and the view geometry in floatexp, the limit is
+        // given by the cost of the reference orbit. It is implemented for
+        // the quadratic sets only, otherwise pixels have to stay apart in
+        // the most precise direct arithmetic available.
+        bool   perturbation = (m_DeepZoom || m_AutoPrecision) && m_Exponent == 2;
+        double maxZoom      = MaxDeepZoom;
+        if (!perturbation) {
+            FractalPrecision precision = m_HaveFp64 ? FractalPrecision::Fp64 :
+                                                      FractalPrecision::DoubleFloat;
+
+            maxZoom = m_Viewport.position.zoom +
+                      PrecisionLadder::getMantissaBits(precision) - getRequiredBits();
+            maxZoom = std::max(maxZoom, 0.0);
+        }
+
         if (m_Viewport.position.zoom > maxZoom) {
             m_Viewport.position.zoom = maxZoom;
         }
@@ -716,6 +1263,10 @@ int AcidbrotApp::updateScene (double dt) {
         }
     }
 
+    // ................................
+    // Fractal precision
+    m_Precision = selectPrecision();
+
     // ................................
     // Timers
     updateTimers(dt);
@@ -725,357 +1276,1188 @@ int AcidbrotApp::updateScene (double dt) {
 
 // ============================================================================
 
-//std::array<float, 2> splitDouble (double x) {
-//    float a = (float)x;
-//    float b = x - (double)a;
-//
-//    return std::array<float, 2>({a, b});
-//}
-//
-//std::array<double, 2> splitLongDouble (long double x) {
-//    double a = (double)x;
-//    double b = x - (long double)a;
-//
-//    return std::array<double, 2>({a, b});
-//}
+FloatExp AcidbrotApp::getViewScale () {
 
-/// Renders the scene
-int AcidbrotApp::renderScene () {
+    // The whole powers of two go to the exponent
+    double whole = floor(m_Viewport.position.zoom);
+    return ldexp(FloatExp(pow(2.0, m_Viewport.position.zoom - whole)), int64_t(whole));
+}
 
-    // ................................
-    // Generate the fractal data
-    {
-        const std::map<Fractal, std::string> shaderName = {
-            {Fractal::Mandelbrot, "mandelbrot"},
-            {Fractal::Julia,      "julia"}
-        };
+double AcidbrotApp::getRequiredBits () {
 
-        GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
-        framebuffer->enable();
+    GL::Framebuffer* fb = m_Framebuffers.at("fractalRaw").get();
 
-        GL::ShaderProgram* shader = m_Shaders.at(shaderName.at(m_Fractal)).get();
-        GL_CHECK(glUseProgram(shader->get()));
+    return PrecisionLadder::getRequiredBits(
+        m_Viewport.position.position,
+        m_Viewport.position.zoom,
+        fb->getWidth(),
+        fb->getHeight()
+        );
+}
 
-        float juliaC[2] = {
-            (float)m_Viewport.position.julia[0] * cosf(m_Viewport.position.julia[1]),
-            (float)m_Viewport.position.julia[0] * sinf(m_Viewport.position.julia[1])
-        };
+size_t AcidbrotApp::getCenterBits () {
+    double bits = std::max(getRequiredBits(), 0.0) + double(CenterGuardBits);
+    return std::max(size_t(ceil(bits)), size_t(BigFloat::DEFAULT_BITS));
+}
 
-        GL_CHECK(glUniform1i(shader->getUniformLocation("fractalIter"),
-                    int(m_Parameters.at("fractalIter").value)
-                    ));
+double AcidbrotApp::getInteriorEpsilon () {
 
-        if (m_HaveFp64) {
+    GL::Framebuffer* fb = m_Framebuffers.at("fractalRaw").get();
 
-            GL_CHECK(glUniform2d(shader->getUniformLocation("fractalPosition"),
-                        m_Viewport.position.position[0],
-                        m_Viewport.position.position[1]
-                        ));
+    // Pixel spacing on the complex plane. The kernels taking it are direct
+    // arithmetic, beyond the double range it underflows to zero.
+    FloatExp spacing = FloatExp(2.0) / (FloatExp(double(fb->getWidth())) * getViewScale());
+    return double(FloatExp(1.0e-3) * spacing);
+}
 
-            GL_CHECK(glUniform1d(shader->getUniformLocation("fractalScale"),
-                        pow(2.0, m_Viewport.position.zoom)
-                        ));
-        }
-        else {
+FractalPrecision AcidbrotApp::selectPrecision () {
 
-            GL_CHECK(glUniform2f(shader->getUniformLocation("fractalPosition"),
-                        m_Viewport.position.position[0],
-                        m_Viewport.position.position[1]
-                        ));
+    // The most precise direct arithmetic available
+    FractalPrecision direct = m_HaveFp64 ? FractalPrecision::Fp64 : FractalPrecision::DoubleFloat;
 
-            GL_CHECK(glUniform1f(shader->getUniformLocation("fractalScale"),
-                        pow(2.0, m_Viewport.position.zoom)
-                        ));
-        }
+    // Deep zoom mode forces perturbation. It is implemented for the
+    // quadratic sets only.
+    if (m_DeepZoom) {
+        return (m_Exponent == 2) ? FractalPrecision::Perturbation : direct;
+    }
 
+    if (!m_AutoPrecision) {
+        return direct;
+    }
 
-        GL_CHECK(glUniform1f(shader->getUniformLocation("fractalRotation"),
-                    m_Viewport.position.rotation
-                    ));
+    // The CPU renderer has its own kernels, for the quadratic sets only
+    PrecisionLadder& ladder = (m_CpuRender && m_Exponent == 2) ? m_CpuLadder : m_Ladder;
 
-        GL_CHECK(glUniform2f(shader->getUniformLocation("fractalCoeff"),
-                    juliaC[0],
-                    juliaC[1]
-                    ));
+    FractalPrecision precision = ladder.select(getRequiredBits());
+    if (precision == FractalPrecision::Perturbation && m_Exponent != 2) {
+        return direct;
+    }
 
-        GL_CHECK(glDisable(GL_BLEND));
+    return precision;
+}
 
-        float viewport[4];
-        GL_CHECK(glGetFloatv(GL_VIEWPORT, viewport));
+void AcidbrotApp::benchmarkFractalShaders () {
+    const size_t runs = 4;
 
-        float aspect = viewport[2] / viewport[3];
+    // Render a view with a lot of boundary that every precision covers
+    Viewport viewport = m_Viewport.position;
+    auto     center   = m_Center;
 
-        float u0 = -1.0f;
-        float u1 = +1.0f;
-        float v0 = -1.0f / aspect;
-        float v1 = +1.0f / aspect;
+    m_Viewport.position.position[0] = -0.743643887;
+    m_Viewport.position.position[1] =  0.131825904;
+    m_Viewport.position.rotation    =  0.0;
+    m_Viewport.position.zoom        =  4.0;
 
-        m_ScreenQuad->draw(-1.0f, -1.0f, +1.0f, +1.0f, u0, v0, u1, v1);
+    m_Center[0] = m_Viewport.position.position[0];
+    m_Center[1] = m_Viewport.position.position[1];
 
-        GL_CHECK(glUseProgram(0));
-        framebuffer->disable();
-    }
+    // Every run must compute the whole field
+    bool useReprojection = m_UseReprojection;
+    m_UseReprojection = false;
 
-    // ................................
-    // Filter the fractal
-    {
-        GL::ShaderProgram* shader = m_Shaders.at("despeckle").get();
-        GL::Framebuffer*   fbSrc  = m_Framebuffers.at("fractalRaw").get();
-        GL::Framebuffer*   fbDst  = m_Framebuffers.at("fractalFlt").get();
+    for (size_t i=0; i<PrecisionLadder::COUNT; ++i) {
+        FractalPrecision precision = FractalPrecision(i);
+        if (!m_Ladder.isAvailable(precision)) {
+            continue;
+        }
 
-        // Setup
-        fbDst->enable();
-        GL_CHECK(glUseProgram(shader->get()));
+        // The first run warms up the shader and computes the reference
+        // orbit so it is not counted
+        double best = INFINITY;
+        for (size_t k=0; k<=runs; ++k) {
+            GL_CHECK(glFinish());
+            double t0 = glfwGetTime();
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbSrc->getTexture()));
+            renderFractalGpu(precision);
 
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT));
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT));
+            GL_CHECK(glFinish());
+            double t1 = glfwGetTime();
 
-        auto& mask = m_Masks.at("despeckle");
+            if (k > 0) {
+                best = std::min(best, t1 - t0);
+            }
+        }
 
-        GL_CHECK(glUniform1i(shader->getUniformLocation("filterTaps"),
-                    mask->getCountForShader()
-                    ));
-        GL_CHECK(glUniform1fv(shader->getUniformLocation("filterWeights"),
-                    mask->getCountForShader(), 
-                    mask->getWeightsForShader()
-                    ));
-        GL_CHECK(glUniform2fv(shader->getUniformLocation("filterOffsets"),
-                    mask->getCountForShader(), 
-                    mask->getOffsetsForShader()
-                    ));
+        m_Ladder.setCost(precision, best);
+        m_Logger->info("Fractal precision {}: {:.2f} ms",
+            getFractalPrecisionName(precision), best * 1e3);
+    }
 
-        // Render
-        m_ScreenQuad->drawFullscreen();
+    // The compute shader engine against the fp32 fragment shader
+    if (m_HaveCompute) {
+        double best = INFINITY;
+        for (size_t k=0; k<=runs; ++k) {
+            GL_CHECK(glFinish());
+            double t0 = glfwGetTime();
 
-        // Cleanup
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+            renderFractalCompute();
 
-        GL_CHECK(glUseProgram(0));
-        fbDst->disable();
-    }
+            GL_CHECK(glFinish());
+            double t1 = glfwGetTime();
 
-    // ................................
-    // Colorize the fractal
-    {
-        GL::ShaderProgram* shader = m_Shaders.at("colorizer").get();
-        GL::Framebuffer*   fbSrc  = m_Framebuffers.at("fractalFlt").get();
-        GL::Framebuffer*   fbDst  = m_Framebuffers.at("fractalColor").get();
+            if (k > 0) {
+                best = std::min(best, t1 - t0);
+            }
+        }
 
-        // Setup
-        fbDst->enable();
-        GL_CHECK(glUseProgram(shader->get()));
+        m_Logger->info("Fractal compute engine: {:.2f} ms ({:.2f}x fp32)",
+            best * 1e3, m_Ladder.getCost(FractalPrecision::Fp32) / best);
+    }
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbSrc->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("fractal"), 0));
+    // Restore the view
+    m_Viewport.position = viewport;
+    m_Center            = center;
+    m_Reference.valid   = false;
+    m_UseReprojection   = useReprojection;
+}
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Textures.at("colormap")->get()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("colormap"), 1));
+// ============================================================================
 
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT));
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT));
+void AcidbrotApp::updateReferenceOrbit () {
 
-        GL_CHECK(glUniform1f(shader->getUniformLocation("colormapPos"), m_Viewport.position.color));
-        setUniforms();
+    auto& ref = m_Reference;
 
-        // Render
-        m_ScreenQuad->drawFullscreen();
+    size_t maxIter = size_t(m_Parameters.at("fractalIter").value);
+    FloatExp scale = getViewScale();
 
-        // Cleanup
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    std::array<double, 2> coeff = {{
+        m_Viewport.position.julia[0] * cos(m_Viewport.position.julia[1]),
+        m_Viewport.position.julia[0] * sin(m_Viewport.position.julia[1])
+    }};
 
-        GL_CHECK(glUseProgram(0));
-        fbDst->disable();
-    }
+    // Check if the current reference is still usable
+    if (ref.valid) {
+        const auto& center = ref.orbit.getCenter();
+        bool stale = false;
 
+        // Fractal type or the Julia set coefficient changed
+        if (ref.orbit.getType() != m_Fractal) {
+            stale = true;
+        }
+        if (m_Fractal == Fractal::Julia && ref.orbit.getCoeff() != coeff) {
+            stale = true;
+        }
 
-    // ................................
-    // Create the halo effect mask
-    {
-        GL::ShaderProgram* shader  = m_Shaders.at("haloMask").get();
-        GL::Framebuffer*   fbIter  = m_Framebuffers.at("fractalFlt").get();
-        GL::Framebuffer*   fbColor = m_Framebuffers.at("fractalColor").get();
-        GL::Framebuffer*   fbDst   = m_Framebuffers.at("haloMask").get();
-//        GL::Framebuffer*   fbDst   = m_Framebuffers.at("master").get();
-
-        // Setup
-        fbDst->enable();
-        GL_CHECK(glUseProgram(shader->get()));
+        // The iteration limit was raised and the reference did not escape
+        if (maxIter > ref.orbit.getMaxIter() && !ref.orbit.hasEscaped()) {
+            stale = true;
+        }
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbIter->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("fractalIter"), 0));
+        // The view moved too far from the reference. Pixel offsets would
+        // lose too much precision.
+        FloatExp dx = FloatExp(m_Center[0] - center[0]) * scale;
+        FloatExp dy = FloatExp(m_Center[1] - center[1]) * scale;
+        if (FloatExp(8.0 * 8.0) < dx*dx + dy*dy) {
+            stale = true;
+        }
 
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT));
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT));
+        if (stale) {
+            ref.valid     = false;
+            ref.relocated = false;
+            ref.attempts  = 0;
+        }
+    }
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbColor->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("fractalColor"), 1));
+    if (ref.valid) {
+        return;
+    }
 
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT));
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT));
+    // Compute the orbit
+    if (!ref.relocated) {
+        ref.center = m_Center;
+    }
 
-        auto& mask = m_Masks.at("edges");
+    ref.orbit.compute(m_Fractal, ref.center, coeff, maxIter);
+    ref.valid    = true;
+    ref.blaValid = false;
 
-        GL_CHECK(glUniform1i(shader->getUniformLocation("filterTaps"),
-                    mask->getCountForShader()
-                    ));
-        GL_CHECK(glUniform1fv(shader->getUniformLocation("filterWeights"),
-                    mask->getCountForShader(), 
-                    mask->getWeightsForShader()
-                    ));
-        GL_CHECK(glUniform2fv(shader->getUniformLocation("filterOffsets"),
-                    mask->getCountForShader(), 
-                    mask->getOffsetsForShader()
-                    ));
+    // Only Julia sets can glitch. Mandelbrot set pixels get rebased.
+    ref.checkGlitches = (m_Fractal == Fractal::Julia);
 
-        // Render
-        m_ScreenQuad->drawFullscreen();
+    // Upload it to a texture
+    const auto& orbit = ref.orbit.getOrbit();
+    size_t rows = (orbit.size() + OrbitTextureWidth - 1) / OrbitTextureWidth;
 
-        // Cleanup
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    auto& texture = m_Textures["refOrbit"];
+    if (!texture || texture->getHeight() < rows) {
+        texture.reset(new GL::Texture(OrbitTextureWidth, rows, GL_RG32F, GL_RG, GL_FLOAT));
+    }
 
-        GL_CHECK(glUseProgram(0));
-        fbDst->disable();
+    std::vector<float> data(2 * texture->getWidth() * texture->getHeight(), 0.0f);
+    for (size_t i=0; i<orbit.size(); ++i) {
+        data[2*i + 0] = orbit[i].real();
+        data[2*i + 1] = orbit[i].imag();
     }
 
-    // ................................
-    // Add the halo effect
-    {
-        GL::ShaderProgram* shader   = m_Shaders.at("halo").get();
-        GL::Framebuffer*   fbColor  = m_Framebuffers.at("fractalColor").get();
-        GL::Framebuffer*   fbMask   = m_Framebuffers.at("haloMask").get();
-        GL::Framebuffer*   fbMaster = m_Framebuffers.at("preScreenFx").get();
+    texture->upload(data.data());
+}
 
-        // Setup
-        GL_CHECK(glUseProgram(shader->get()));
+void AcidbrotApp::checkGlitches () {
+    const size_t maxAttempts = 4;
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbColor->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("texture"), 0));
+    auto& ref = m_Reference;
+    ref.checkGlitches = false;
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbMask->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("haloMask"), 1));
+    // Download the fractal
+    GL::Framebuffer* fb = m_Framebuffers.at("fractalRaw").get();
+    auto data = fb->readPixels();
 
-        setUniforms();
+    size_t width  = fb->getWidth();
+    size_t height = fb->getHeight();
 
-        GL_CHECK(glUniform1i(shader->getUniformLocation("haloSteps"),
-                    int(m_Parameters.at("haloSteps").value)
-                    ));
+    // Glitched pixels are marked with -0.5 (see iter.fsh)
+    const float* values = (const float*)data.get();
+    auto isGlitched = [&](size_t x, size_t y) {
+        float v = values[y * width + x];
+        return (v < -0.25f && v > -0.75f);
+    };
 
-        fbMaster->enable();
+    // Find the centroid of glitched pixels
+    size_t count = 0;
+    double sumX  = 0.0;
+    double sumY  = 0.0;
+
+    for (size_t y=0; y<height; ++y) {
+        for (size_t x=0; x<width; ++x) {
+            if (isGlitched(x, y)) {
+                sumX += x;
+                sumY += y;
+                count++;
+            }
+        }
+    }
 
-        // Render
-        m_ScreenQuad->drawFullscreen();
+    if (count == 0 || ref.attempts >= maxAttempts) {
+        return;
+    }
 
-        // Cleanup
-        fbMaster->disable();
+    // Pick the glitched pixel closest to the centroid
+    double cx = sumX / count;
+    double cy = sumY / count;
+
+    size_t bestX = 0;
+    size_t bestY = 0;
+    double bestD = INFINITY;
+
+    for (size_t y=0; y<height; ++y) {
+        for (size_t x=0; x<width; ++x) {
+            double d = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+            if (d < bestD && isGlitched(x, y)) {
+                bestX = x;
+                bestY = y;
+                bestD = d;
+            }
+        }
+    }
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    m_Logger->debug("Deep zoom: {} glitched pixels, re-referencing at ({}, {})",
+                    count, bestX, bestY);
 
-        GL_CHECK(glUseProgram(0));
+    // Compute its position on the complex plane. The whole powers of two of
+    // the scale are applied exactly.
+    double aspect = (double)width / (double)height;
+    double whole  = floor(m_Viewport.position.zoom);
+    double scale  = pow(2.0, m_Viewport.position.zoom - whole);
+    double s      = sin(m_Viewport.position.rotation);
+    double c      = cos(m_Viewport.position.rotation);
+
+    double u = (-1.0 + 2.0 * (bestX + 0.5) / width);
+    double v = (-1.0 + 2.0 * (bestY + 0.5) / height) / aspect;
+
+    ref.center[0] = m_Center[0] + ldexp(BigFloat((c * u - s * v) / scale), -int64_t(whole));
+    ref.center[1] = m_Center[1] + ldexp(BigFloat((s * u + c * v) / scale), -int64_t(whole));
+
+    ref.relocated = true;
+    ref.valid     = false;
+    ref.attempts++;
+}
+
+void AcidbrotApp::updateSeriesApprox () {
+
+    auto& ref = m_Reference;
+
+    size_t terms   = size_t(m_Parameters.at("fractalSeries").value);
+    size_t maxIter = size_t(m_Parameters.at("fractalIter").value);
+
+    // The view geometry. Offsets are in floatexp, the approximation is
+    // not limited by the double range.
+    GL::Framebuffer* fb = m_Framebuffers.at("fractalRaw").get();
+    double aspect = (double)fb->getWidth() / (double)fb->getHeight();
+    double s      = sin(m_Viewport.position.rotation);
+    double c      = cos(m_Viewport.position.rotation);
+
+    FloatExp invScale = FloatExp(1.0) / getViewScale();
+
+    const auto& center = ref.orbit.getCenter();
+    ComplexExp offset (
+        FloatExp(m_Center[0] - center[0]),
+        FloatExp(m_Center[1] - center[1])
+    );
+
+    // Probe the view corners and edge midpoints
+    std::vector<ComplexExp> probes;
+    FloatExp radius = 0.0;
+
+    for (int y=-1; y<=+1; ++y) {
+        for (int x=-1; x<=+1; ++x) {
+            if (x == 0 && y == 0) {
+                continue;
+            }
+
+            double u = x;
+            double v = y / aspect;
+
+            ComplexExp probe = offset + ComplexExp(SeriesApprox::Complex(
+                c * u - s * v,
+                s * u + c * v
+            )) * invScale;
+
+            probes.push_back(probe);
+            if (radius < abs(probe)) {
+                radius = abs(probe);
+            }
+        }
     }
 
-    // ................................
-    // Noise displacement
+    ref.series.compute(ref.orbit, probes, radius, terms, maxIter);
+}
+
+void AcidbrotApp::updateBlaTable () {
+
+    auto& ref = m_Reference;
+
+    // Bound of pixel offsets from the reference point
+    GL::Framebuffer* fb = m_Framebuffers.at("fractalRaw").get();
+    double aspect = (double)fb->getWidth() / (double)fb->getHeight();
+
+    const auto& center = ref.orbit.getCenter();
+    ComplexExp offset (
+        FloatExp(m_Center[0] - center[0]),
+        FloatExp(m_Center[1] - center[1])
+    );
+
+    FloatExp maxOffset = abs(offset) +
+                         FloatExp(sqrt(1.0 + 1.0 / (aspect * aspect))) / getViewScale();
+
+    // Rebuild when the view no longer fits or when zoomed in considerably
+    // as a tighter bound permits longer steps.
+    const FloatExp& tableOffset = ref.blaOffset;
+    if (ref.blaValid && maxOffset <= tableOffset && tableOffset <= maxOffset * 16.0) {
+        return;
+    }
+
+    // The table itself is in doubles. The bound only shrinks step radii by
+    // products with it, below the double range they are negligible.
+    ref.blaOffset = maxOffset * 2.0;
+    ref.bla.build(ref.orbit, double(ref.blaOffset));
+    ref.blaValid = true;
+
+    // Flatten levels. Each step takes two texels: (A, B) and (R, log2(R), -, -)
+    // The logarithm is compared to floatexp deltas, R is out of the fp32
+    // range for them. Steps with coefficients out of fp32 range are disabled.
+    const float maxCoeff = 1e30f;
+
+    std::vector<float> steps;
+    ref.blaOffsets.clear();
+
+    size_t levels = std::min(ref.bla.getLevelCount(), MaxBlaLevels);
+    for (size_t k=0; k<levels; ++k) {
+        ref.blaOffsets.push_back(GLint(steps.size() / 8));
+
+        for (const auto& step : ref.bla.getLevel(k)) {
+            bool inRange = std::abs(step.a) < maxCoeff &&
+                           std::abs(step.b) < maxCoeff;
+
+            steps.push_back(step.a.real());
+            steps.push_back(step.a.imag());
+            steps.push_back(step.b.real());
+            steps.push_back(step.b.imag());
+            steps.push_back(inRange ? step.radius : 0.0);
+            steps.push_back((inRange && step.radius > 0.0) ? log2(step.radius) : -1.0e30);
+            steps.push_back(0.0f);
+            steps.push_back(0.0f);
+        }
+    }
+
+    // Upload
+    size_t texels = steps.size() / 4;
+    size_t rows   = std::max<size_t>(1, (texels + BlaTextureWidth - 1) / BlaTextureWidth);
+
+    auto& texture = m_Textures["blaTable"];
+    if (!texture || texture->getHeight() < rows) {
+        texture.reset(new GL::Texture(BlaTextureWidth, rows, GL_RGBA32F, GL_RGBA, GL_FLOAT));
+    }
+
+    steps.resize(4 * texture->getWidth() * texture->getHeight(), 0.0f);
+    texture->upload(steps.data());
+}
+
+void AcidbrotApp::renderFractalCpu () {
+
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+
+    size_t width  = framebuffer->getWidth();
+    size_t height = framebuffer->getHeight();
+
+    // Same parameters as the fractal shaders get
+    CpuKernelArgs args;
+    args.type        = m_Fractal;
+    args.position[0] = m_Viewport.position.position[0];
+    args.position[1] = m_Viewport.position.position[1];
+    args.rotation    = m_Viewport.position.rotation;
+    args.scale       = pow(2.0, m_Viewport.position.zoom);
+    args.coeff[0]    = (float)m_Viewport.position.julia[0] * cosf(m_Viewport.position.julia[1]);
+    args.coeff[1]    = (float)m_Viewport.position.julia[0] * sinf(m_Viewport.position.julia[1]);
+    args.maxIter     = size_t(m_Parameters.at("fractalIter").value);
+    args.interior    = m_InteriorChecks;
+    args.epsilon     = getInteriorEpsilon();
+    args.width       = width;
+    args.height      = height;
+
+    m_CpuField.resize(width * height);
+    m_CpuTexels.resize(width * height);
+
+    // Composite from cached tiles as long as the view is shallow enough for
+    // them to be addressed
+    m_TileCached = m_UseTileCache && TileCache::isCachable(args);
+    if (m_TileCached) {
+        TileCache::Params params;
+        params.type     = args.type;
+        params.coeff[0] = args.coeff[0];
+        params.coeff[1] = args.coeff[1];
+        params.maxIter  = args.maxIter;
+        params.interior = args.interior;
+
+        // Deep views are located by their exact center
+        args.center[0] = Fixed128(m_Center[0]);
+        args.center[1] = Fixed128(m_Center[1]);
+
+        m_TileCache->setParams(params);
+        m_TileCache->composite(args, m_CpuField.data());
+    }
+
+    // Render in fixed point from the extended precision center
+    else if (m_Precision == FractalPrecision::Fixed128) {
+        args.center[0] = Fixed128(m_Center[0]);
+        args.center[1] = Fixed128(m_Center[1]);
+        m_CpuRenderer->render(args, cpuKernelFixed128, m_CpuField.data(), &m_CpuStats);
+    }
+
+    // Render by perturbation. Iterations are skipped with the BLA table the
+    // shader gets, there is no series approximation on the CPU.
+    else if (m_Precision == FractalPrecision::Perturbation) {
+        updateReferenceOrbit();
+        updateBlaTable();
+
+        const auto& center = m_Reference.orbit.getCenter();
+
+        CpuPerturbation perturbation;
+        perturbation.orbit    = &m_Reference.orbit;
+        perturbation.bla      = &m_Reference.bla;
+        perturbation.invScale = FloatExp(1.0) / getViewScale();
+        perturbation.offset   = ComplexExp(
+            FloatExp(m_Center[0] - center[0]),
+            FloatExp(m_Center[1] - center[1])
+        );
+
+        args.perturbation = &perturbation;
+        m_CpuRenderer->render(args, cpuKernelPerturbation, m_CpuField.data(), &m_CpuStats);
+    }
+
+    // Render. There is no double-float kernel, double covers it.
+    else {
+        bool isDouble = (m_Precision != FractalPrecision::Fp32);
+        m_CpuRenderer->render(args, isDouble, m_CpuField.data(), &m_CpuStats);
+    }
+
+    CpuRenderer::encode(m_CpuField.data(), m_CpuField.size(), args.maxIter, m_CpuTexels.data());
+
+    // Upload
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, framebuffer->getTexture()));
+    GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height,
+                             GL_RED, GL_FLOAT, m_CpuTexels.data()));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+
+    // Look for glitches after the reference changed, the same as for the
+    // shader
+    if (!m_TileCached && m_Precision == FractalPrecision::Perturbation &&
+        m_Reference.checkGlitches)
     {
-        GL::ShaderProgram* shader   = m_Shaders.at("noise_displacement").get();
-        GL::Framebuffer*   fbColor  = m_Framebuffers.at("preScreenFx").get();
-        GL::Framebuffer*   fbMaster = m_Framebuffers.at("master").get();
+        checkGlitches();
+    }
+}
 
-        // Setup
-        GL_CHECK(glUseProgram(shader->get()));
+void AcidbrotApp::renderFractalCompute () {
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbColor->getTexture()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("color"), 0));
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
 
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT));
-        GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT));
+    size_t width  = framebuffer->getWidth();
+    size_t height = framebuffer->getHeight();
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_3D, m_Textures3d.at("noise")->get()));
-        GL_CHECK(glUniform1i(shader->getUniformLocation("noise"), 1));
+    // Worklists of pixels still iterating, two of them swapped each
+    // dispatch, and their counts
+    const size_t itemSize  = 32;
+    const size_t itemsSize = width * height * itemSize;
 
-        setUniforms();
+    auto& items0 = m_Buffers["computeItems0"];
+    auto& items1 = m_Buffers["computeItems1"];
 
-        GL_CHECK(glUniform1f(shader->getUniformLocation("time"), m_Timers.at("weave")));
+    if (!items0 || items0->getSize() != itemsSize) {
+        items0.reset(new GL::StorageBuffer(itemsSize));
+        items1.reset(new GL::StorageBuffer(itemsSize));
+    }
 
-        fbMaster->enable();
+    auto& control = m_Buffers["computeControl"];
+    if (!control) {
+        control.reset(new GL::StorageBuffer(4 * sizeof(GLuint)));
+    }
 
-        GL_CHECK(glEnable(GL_BLEND));
-        GL_CHECK(glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD));
-        GL_CHECK(glBlendFuncSeparate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA, GL_ONE, GL_ZERO));
-        GL_CHECK(glBlendColor(0.0f, 0.0f, 0.0f, m_Parameters.at("motionBlur").value));
+    GL::StorageBuffer* items[2] = {items0.get(), items1.get()};
 
-        // Render
-        m_ScreenQuad->drawFullscreen();
+    std::string name = (m_Fractal == Fractal::Julia) ? "juliaCompute" : "mandelbrotCompute";
+    GL::ShaderProgram* shader = m_Shaders.at(name).get();
+    GL_CHECK(glUseProgram(shader->get()));
 
-        // Cleanup
-        fbMaster->disable();
+    // Same parameters as the fp32 fractal shaders get
+    int maxIter = int(m_Parameters.at("fractalIter").value);
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
-        GL_CHECK(glActiveTexture(GL_TEXTURE1));
-        GL_CHECK(glBindTexture(GL_TEXTURE_3D, 0));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractalIter"),
+                maxIter
+                ));
+    GL_CHECK(glUniform2f(shader->getUniformLocation("fractalPosition"),
+                m_Viewport.position.position[0],
+                m_Viewport.position.position[1]
+                ));
+    GL_CHECK(glUniform1f(shader->getUniformLocation("fractalScale"),
+                pow(2.0, m_Viewport.position.zoom)
+                ));
+    GL_CHECK(glUniform1f(shader->getUniformLocation("fractalRotation"),
+                m_Viewport.position.rotation
+                ));
+    GL_CHECK(glUniform2f(shader->getUniformLocation("fractalCoeff"),
+                (float)m_Viewport.position.julia[0] * cosf(m_Viewport.position.julia[1]),
+                (float)m_Viewport.position.julia[0] * sinf(m_Viewport.position.julia[1])
+                ));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractalInterior"),
+                int(m_InteriorChecks)
+                ));
+    GL_CHECK(glUniform1f(shader->getUniformLocation("fractalEpsilon"),
+                getInteriorEpsilon()
+                ));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("computeChunk"),
+                ComputeChunk
+                ));
 
-        GL_CHECK(glDisable(GL_BLEND));
+    GL_CHECK(glBindImageTexture(0, framebuffer->getTexture(), 0, GL_FALSE, 0,
+                                GL_WRITE_ONLY, GL_R32F));
+    control->bind(0);
 
-        GL_CHECK(glUseProgram(0));
+    // Every dispatch iterates the pixels left by the previous one for a
+    // chunk. The first one starts all the pixels.
+    int rounds = (maxIter + ComputeChunk - 1) / ComputeChunk;
+    for (int i=0; i<rounds; ++i) {
+        int in = i & 1;
+
+        // Clear the output count and the batch cursor
+        control->fill(1 - in, 1, 0);
+        control->fill(2, 1, 0);
+
+        items[in]->bind(1);
+        items[1 - in]->bind(2);
+
+        GL_CHECK(glUniform1i(shader->getUniformLocation("computeInit"), i == 0));
+        GL_CHECK(glUniform1i(shader->getUniformLocation("computeIn"),   in));
+
+        GL_CHECK(glDispatchCompute(ComputeGroups, 1, 1));
+        GL_CHECK(glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT));
     }
 
-    // ................................
-    // Convert "master" to "masterYUV"
-    if (m_VideoRec.running) {
-        GL::ShaderProgram* shader = m_Shaders.at("colorConv").get();
-        GL::Framebuffer*   fbSrc  = m_Framebuffers.at("master").get();
-        GL::Framebuffer*   fbDst  = m_Framebuffers.at("masterYUV").get();
+    // The field is sampled and read back as a framebuffer later
+    GL_CHECK(glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT |
+                             GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                             GL_FRAMEBUFFER_BARRIER_BIT));
 
-        // Setup
-        GL_CHECK(glUseProgram(shader->get()));
+    GL_CHECK(glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F));
+    GL_CHECK(glUseProgram(0));
+}
 
-        GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbSrc->getTexture()));
-
-        // BT.709
-        // https://en.wikipedia.org/wiki/YUV
-        float matConv[] = {
-             0.21260, 0.71520,  0.07220,
-            -0.09991,-0.33609,  0.43600,
-             0.61500,-0.55861, -0.05639
-        };
+// ============================================================================
 
-        GL_CHECK(glUniformMatrix3fv(shader->getUniformLocation("matConv"), 1, GL_TRUE, matConv));
+/// Splits a double into high and low floats for double-float shaders
+static std::array<float, 2> splitDouble (double x) {
+    float a = (float)x;
+    float b = (float)(x - (double)a);
 
-        fbDst->enable();
+    return std::array<float, 2>({{a, b}});
+}
 
-        // Render (flipped)
-        m_ScreenQuad->draw(-1.0f, -1.0f, +1.0f, +1.0f,
-                            0.0f,  1.0f,  1.0f,  0.0f);
+void AcidbrotApp::renderFractalGpu (FractalPrecision a_Precision) {
 
-        // Cleanup
-        fbDst->disable();
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+
+    beginFractalGpu(a_Precision);
+    drawFractalGpu(0, 0, framebuffer->getWidth(), framebuffer->getHeight());
+    endFractalGpu();
+}
+
+void AcidbrotApp::renderFractalProgressive (FractalPrecision a_Precision) {
+
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+
+    // Start a new field once the previous one is complete
+    if (!m_Progress.isActive()) {
+        beginFractalGpu(a_Precision);
+        m_Progress.start(framebuffer->getWidth(), framebuffer->getHeight());
+    }
+
+    // Render tiles while they fit the budget. Waiting for each tile gives
+    // its actual cost.
+    double t0 = glfwGetTime();
+
+    FractalProgress::Tile tile;
+    while (m_Progress.next(glfwGetTime() - t0, ProgressiveBudget, &tile)) {
+        double t1 = glfwGetTime();
+
+        drawFractalGpu(tile.x, tile.y, tile.width, tile.height);
+        GL_CHECK(glFinish());
+
+        m_Progress.done(tile, glfwGetTime() - t1);
+    }
+
+    if (m_Progress.isDone()) {
+        endFractalGpu();
+        m_Progress.reset();
+    }
+}
+
+GL::Framebuffer* AcidbrotApp::getFractalField () {
+
+    // The previous field is shown until the current one is complete
+    if (m_Progress.isActive()) {
+        return m_Framebuffers.at("fractalPrev").get();
+    }
+
+    return m_Framebuffers.at("fractalRaw").get();
+}
+
+void AcidbrotApp::beginFractalGpu (FractalPrecision a_Precision) {
+
+    bool isPerturb = (a_Precision == FractalPrecision::Perturbation);
+
+    // Update the reference orbit
+    if (isPerturb) {
+        updateReferenceOrbit();
+
+        if (m_UseBla) {
+            updateBlaTable();
+        } else {
+            updateSeriesApprox();
+        }
+    }
+
+    // Reproject the previous field. Perturbation renders it from scratch.
+    std::swap(m_Framebuffers.at("fractalRaw"), m_Framebuffers.at("fractalPrev"));
+
+    FractalReprojection::View view = getReprojectionView();
+    view.valid = !isPerturb;
+
+    m_Reprojection = FractalReprojection();
+    if (!isPerturb) {
+        m_Reprojection = FractalReprojection::compute(m_ReprojView, view);
+        m_Reprojection.enabled &= m_UseReprojection;
+    }
+
+    m_ReprojView = view;
+
+    // Parameters of the field. They hold for all its tiles.
+    auto& job = m_FractalJob;
+    job.precision = a_Precision;
+    job.type      = m_Fractal;
+    job.position  = m_Viewport.position;
+    job.center    = m_Center;
+    job.maxIter   = int(m_Parameters.at("fractalIter").value);
+    job.interior  = m_InteriorChecks;
+    job.epsilon   = getInteriorEpsilon();
+    job.useBla    = m_UseBla;
+    job.exponent  = m_Exponent;
+    job.unroll    = m_Unroll;
+
+    // Symmetry. Perturbation deltas are relative to the reference orbit
+    // which breaks it. Julia sets of odd exponents are not symmetric under
+    // z -> -z.
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+
+    bool symmetric = (m_Fractal == Fractal::Mandelbrot) || (m_Exponent % 2 == 0);
+
+    m_Symmetry = FractalSymmetry();
+    if (m_UseSymmetry && symmetric && !isPerturb) {
+        m_Symmetry = FractalSymmetry::compute(
+            m_Fractal,
+            m_Viewport.position.position,
+            m_Viewport.position.rotation,
+            pow(2.0, m_Viewport.position.zoom),
+            framebuffer->getWidth(),
+            framebuffer->getHeight()
+            );
+    }
+}
+
+void AcidbrotApp::drawFractalGpu (size_t a_X, size_t a_Y, size_t a_Width, size_t a_Height) {
+
+    const auto& job = m_FractalJob;
+    bool isPerturb  = (job.precision == FractalPrecision::Perturbation);
+
+    // Render the non-redundant part, the mirror pass completes it
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+    if (m_Symmetry.enabled) {
+        framebuffer = m_Framebuffers.at("fractalHalf").get();
+    }
+
+    framebuffer->enable();
+
+    FractalVariant variant;
+    variant.type      = job.type;
+    variant.precision = job.precision;
+    variant.exponent  = job.exponent;
+    variant.interior  = job.interior;
+    variant.unroll    = job.unroll;
+
+    GL::ShaderProgram* shader = m_FractalShaders->get(variant);
+    GL_CHECK(glUseProgram(shader->get()));
+
+    float juliaC[2] = {
+        (float)job.position.julia[0] * cosf(job.position.julia[1]),
+        (float)job.position.julia[0] * sinf(job.position.julia[1])
+    };
+
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractalIter"),
+                job.maxIter
+                ));
+
+    if (isPerturb) {
+        const auto& center = m_Reference.orbit.getCenter();
+
+        // Offsets are passed in units of 2^exponent, they are out of the
+        // fp32 range at deep zooms
+        double  whole    = floor(job.position.zoom);
+        int64_t exponent = -int64_t(whole);
+
+        ComplexExp::Complex offset (ldexp(ComplexExp(
+            FloatExp(job.center[0] - center[0]),
+            FloatExp(job.center[1] - center[1])
+            ), -exponent));
+
+        GL_CHECK(glUniform1i(shader->getUniformLocation("deltaExponent"),
+                    int(exponent)
+                    ));
 
         GL_CHECK(glActiveTexture(GL_TEXTURE0));
-        GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+        GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Textures.at("refOrbit")->get()));
+        GL_CHECK(glUniform1i(shader->getUniformLocation("refOrbit"), 0));
 
-        GL_CHECK(glUseProgram(0));
+        GL_CHECK(glUniform1i(shader->getUniformLocation("refLength"),
+                    int(m_Reference.orbit.getLength())
+                    ));
+
+        GL_CHECK(glUniform2f(shader->getUniformLocation("refOffset"),
+                    offset.real(),
+                    offset.imag()
+                    ));
+
+        GL_CHECK(glUniform1f(shader->getUniformLocation("fractalScale"),
+                    pow(2.0, job.position.zoom - whole)
+                    ));
+
+        // BLA table
+        if (job.useBla) {
+            GL_CHECK(glActiveTexture(GL_TEXTURE1));
+            GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Textures.at("blaTable")->get()));
+            GL_CHECK(glUniform1i(shader->getUniformLocation("blaTable"), 1));
+
+            const auto& offsets = m_Reference.blaOffsets;
+            GL_CHECK(glUniform1i(shader->getUniformLocation("blaLevels"),
+                        int(offsets.size())
+                        ));
+
+            if (!offsets.empty()) {
+                GL_CHECK(glUniform1iv(shader->getUniformLocation("blaOffsets"),
+                            offsets.size(), offsets.data()
+                            ));
+            }
+        }
+        else {
+            GL_CHECK(glUniform1i(shader->getUniformLocation("blaLevels"), 0));
+        }
+
+        // Series approximation. The coefficients are passed in units of
+        // 2^seriesExponent, that of the largest one.
+        const auto& series = m_Reference.series;
+        const auto& coeffs = series.getCoeffs();
+
+        int64_t seriesExponent = INT64_MIN;
+        for (const auto& coeff : coeffs) {
+            if (coeff.getMantissa() != ComplexExp::Complex(0.0, 0.0)) {
+                seriesExponent = std::max(seriesExponent, coeff.getExponent());
+            }
+        }
+        if (seriesExponent == INT64_MIN) {
+            seriesExponent = 0;
+        }
+
+        std::vector<float> seriesCoeffs;
+        for (const auto& coeff : coeffs) {
+            ComplexExp::Complex value (ldexp(coeff, -seriesExponent));
+            seriesCoeffs.push_back(value.real());
+            seriesCoeffs.push_back(value.imag());
+        }
+
+        GL_CHECK(glUniform1i(shader->getUniformLocation("seriesSkip"),
+                    job.useBla ? 0 : int(series.getSkip())
+                    ));
+        GL_CHECK(glUniform1i(shader->getUniformLocation("seriesTerms"),
+                    int(coeffs.size())
+                    ));
+        GL_CHECK(glUniform1f(shader->getUniformLocation("seriesRadius"),
+                    (double)ldexp(series.getRadius(), -exponent)
+                    ));
+        GL_CHECK(glUniform1i(shader->getUniformLocation("seriesExponent"),
+                    int(seriesExponent)
+                    ));
+
+        if (!coeffs.empty()) {
+            GL_CHECK(glUniform2fv(shader->getUniformLocation("seriesCoeffs"),
+                        coeffs.size(), seriesCoeffs.data()
+                        ));
+        }
     }
+    else if (job.precision == FractalPrecision::Fp64) {
+
+        GL_CHECK(glUniform2d(shader->getUniformLocation("fractalPosition"),
+                    job.position.position[0],
+                    job.position.position[1]
+                    ));
 
+        GL_CHECK(glUniform1d(shader->getUniformLocation("fractalScale"),
+                    pow(2.0, job.position.zoom)
+                    ));
+    }
+    else if (job.precision == FractalPrecision::DoubleFloat) {
+        auto posX  = splitDouble(job.position.position[0]);
+        auto posY  = splitDouble(job.position.position[1]);
+        auto scale = splitDouble(pow(2.0, job.position.zoom));
+
+        GL_CHECK(glUniform4f(shader->getUniformLocation("fractalPosition"),
+                    posX[0], posX[1], posY[0], posY[1]
+                    ));
+
+        GL_CHECK(glUniform2f(shader->getUniformLocation("fractalScale"),
+                    scale[0], scale[1]
+                    ));
+    }
+    else {
+
+        GL_CHECK(glUniform2f(shader->getUniformLocation("fractalPosition"),
+                    job.position.position[0],
+                    job.position.position[1]
+                    ));
+
+        GL_CHECK(glUniform1f(shader->getUniformLocation("fractalScale"),
+                    pow(2.0, job.position.zoom)
+                    ));
+    }
+
+    GL_CHECK(glUniform1f(shader->getUniformLocation("fractalRotation"),
+                job.position.rotation
+                ));
+
+    // Interior checks, symmetry and reprojection. The perturbation shader
+    // has none.
+    if (!isPerturb) {
+        setSymmetryUniforms(shader);
+        setReprojectionUniforms(shader);
+
+        GL_CHECK(glUniform1i(shader->getUniformLocation("fractalInterior"),
+                    int(job.interior)
+                    ));
+        GL_CHECK(glUniform1f(shader->getUniformLocation("fractalEpsilon"),
+                    job.epsilon
+                    ));
+    }
+
+    GL_CHECK(glUniform2f(shader->getUniformLocation("fractalCoeff"),
+                juliaC[0],
+                juliaC[1]
+                ));
+
+    GL_CHECK(glDisable(GL_BLEND));
+
+    float viewport[4];
+    GL_CHECK(glGetFloatv(GL_VIEWPORT, viewport));
+
+    float aspect = viewport[2] / viewport[3];
+
+    float u0 = -1.0f;
+    float u1 = +1.0f;
+    float v0 = -1.0f / aspect;
+    float v1 = +1.0f / aspect;
+
+    GL_CHECK(glEnable(GL_SCISSOR_TEST));
+    GL_CHECK(glScissor(a_X, a_Y, a_Width, a_Height));
+
+    m_ScreenQuad->draw(-1.0f, -1.0f, +1.0f, +1.0f, u0, v0, u1, v1);
+
+    GL_CHECK(glDisable(GL_SCISSOR_TEST));
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE2));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CHECK(glActiveTexture(GL_TEXTURE1));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CHECK(glActiveTexture(GL_TEXTURE0));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+
+    GL_CHECK(glUseProgram(0));
+    framebuffer->disable();
+}
+
+void AcidbrotApp::endFractalGpu () {
+
+    bool isPerturb = (m_FractalJob.precision == FractalPrecision::Perturbation);
+
+    // Fill in redundant pixels
+    if (m_Symmetry.enabled) {
+        renderMirror();
+    }
+
+    // Look for glitches after the reference changed
+    if (isPerturb && m_Reference.checkGlitches) {
+        checkGlitches();
+    }
+}
+
+void AcidbrotApp::setSymmetryUniforms (GL::ShaderProgram* a_Shader) {
+
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+    float aspect = float(framebuffer->getWidth()) / float(framebuffer->getHeight());
+
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("fractalSymmetry"),
+                m_Symmetry.enabled
+                ));
+    GL_CHECK(glUniformMatrix2fv(a_Shader->getUniformLocation("fractalMirror"),
+                1, GL_TRUE, m_Symmetry.mirror.data()
+                ));
+    GL_CHECK(glUniform2fv(a_Shader->getUniformLocation("fractalMirrorOffset"),
+                1, m_Symmetry.offset.data()
+                ));
+    GL_CHECK(glUniform3fv(a_Shader->getUniformLocation("fractalMirrorHalf"),
+                1, m_Symmetry.half.data()
+                ));
+    GL_CHECK(glUniform1f(a_Shader->getUniformLocation("fractalAspect"),
+                aspect
+                ));
+}
+
+void AcidbrotApp::setReprojectionUniforms (GL::ShaderProgram* a_Shader) {
+
+    GL::Framebuffer* fbPrev = m_Framebuffers.at("fractalPrev").get();
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE0));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbPrev->getTexture(0)));
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("reprojIter"), 0));
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE1));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbPrev->getTexture(1)));
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("reprojError"), 1));
+
+    // Without states nothing is resumed and the sampler reads zeros
+    GL_CHECK(glActiveTexture(GL_TEXTURE2));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_UseResume ? fbPrev->getTexture(2) : 0));
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("reprojState"), 2));
+
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("reprojEnabled"),
+                m_Reprojection.enabled
+                ));
+    GL_CHECK(glUniform1i(a_Shader->getUniformLocation("reprojResume"),
+                m_Reprojection.resume
+                ));
+    GL_CHECK(glUniformMatrix2fv(a_Shader->getUniformLocation("reprojMatrix"),
+                1, GL_TRUE, m_Reprojection.matrix.data()
+                ));
+    GL_CHECK(glUniform2fv(a_Shader->getUniformLocation("reprojOffset"),
+                1, m_Reprojection.offset.data()
+                ));
+    GL_CHECK(glUniform1f(a_Shader->getUniformLocation("reprojPixelScale"),
+                m_Reprojection.pixelScale
+                ));
+    GL_CHECK(glUniform1f(a_Shader->getUniformLocation("reprojMaxError"),
+                m_Reprojection.getMaxError()
+                ));
+}
+
+FractalReprojection::View AcidbrotApp::getReprojectionView () {
+
+    GL::Framebuffer* framebuffer = m_Framebuffers.at("fractalRaw").get();
+
+    FractalReprojection::View view;
+    view.valid    = true;
+    view.type     = m_Fractal;
+    view.position = m_Viewport.position.position;
+    view.rotation = m_Viewport.position.rotation;
+    view.scale    = pow(2.0, m_Viewport.position.zoom);
+    view.coeff    = m_Viewport.position.julia;
+    view.exponent = m_Exponent;
+    view.maxIter  = size_t(m_Parameters.at("fractalIter").value);
+    view.interior = m_InteriorChecks;
+    view.width    = framebuffer->getWidth();
+    view.height   = framebuffer->getHeight();
+    view.state    = m_UseResume;
+
+    return view;
+}
+
+void AcidbrotApp::renderMirror () {
+
+    GL::ShaderProgram* shader = m_Shaders.at("mirror").get();
+    GL::Framebuffer*   fbSrc  = m_Framebuffers.at("fractalHalf").get();
+    GL::Framebuffer*   fbDst  = m_Framebuffers.at("fractalRaw").get();
+
+    // Setup
+    fbDst->enable();
+    GL_CHECK(glUseProgram(shader->get()));
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE0));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbSrc->getTexture(0)));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractal"), 0));
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE1));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, fbSrc->getTexture(1)));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractalError"), 1));
+
+    GL_CHECK(glActiveTexture(GL_TEXTURE2));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_UseResume ? fbSrc->getTexture(2) : 0));
+    GL_CHECK(glUniform1i(shader->getUniformLocation("fractalState"), 2));
+
+    setSymmetryUniforms(shader);
+
+    // Render with the same screen coordinates as the fractal
+    float aspect = float(fbDst->getWidth()) / float(fbDst->getHeight());
+    m_ScreenQuad->draw(-1.0f, -1.0f, +1.0f, +1.0f,
+                       -1.0f, -1.0f / aspect, +1.0f, +1.0f / aspect);
+
+    // Cleanup
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CHECK(glActiveTexture(GL_TEXTURE1));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CHECK(glActiveTexture(GL_TEXTURE0));
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+
+    GL_CHECK(glUseProgram(0));
+    fbDst->disable();
+}
+
+bool AcidbrotApp::isViewMoving () {
+
+    const auto& v = m_Viewport.velocity;
+
+    // Screen pixels per unit of the screen space
+    double k = 0.5 * double(m_RenderGraph.getTarget("master")->getWidth());
+
+    // Lateral motion is in screen units already
+    double speed = k * (hypot(v.position[0], v.position[1]) +
+                        fabs(v.rotation) + fabs(v.zoom) * M_LN2);
+
+    // Changes of the Julia set coefficient move the whole set. Scaled in
+    // floatexp, at deep zooms any change is a move.
+    if (m_Fractal == Fractal::Julia) {
+        FloatExp julia = fabs(v.julia[0]) + m_Viewport.position.julia[0] * fabs(v.julia[1]);
+        speed += double(FloatExp(k) * julia * getViewScale());
+    }
+
+    return speed > MovingSpeed;
+}
+
+void AcidbrotApp::updateResolution () {
+
+    // Pass time of a previous frame. GPU times arrive a few frames late.
+    double time     = 0.0;
+    bool   measured = m_FractalTimer->getResult(&time);
+
+    if (m_CpuFractalTime >= 0.0) {
+        time             = m_CpuFractalTime;
+        measured         = true;
+        m_CpuFractalTime = -1.0;
+    }
+
+    // Full resolution for a still view. Progressive rendering keeps its own
+    // budget.
+    bool changed = false;
+    if (!m_UseGovernor || m_Progressive || !isViewMoving()) {
+        changed = m_Governor.reset();
+    }
+    else if (measured) {
+        changed = m_Governor.update(time, 1.0 / m_TargetFrameRate);
+    }
+
+    if (changed) {
+        initializeFractalFramebuffers();
+    }
+}
+
+/// Renders the scene
+int AcidbrotApp::renderScene () {
+
+    // ................................
+    // Generate the fractal data. Other exponents than 2 are GPU fragment
+    // shader only.
+    updateResolution();
+
+    bool quadratic = (m_Exponent == 2);
+
+    m_CpuRendered     = m_CpuRender && quadratic;
+    m_ComputeRendered = !m_CpuRendered && quadratic && m_UseCompute && m_HaveCompute &&
+                        m_Precision == FractalPrecision::Fp32;
+
+    if (m_CpuRendered) {
+        m_Symmetry         = FractalSymmetry();
+        m_Reprojection     = FractalReprojection();
+        m_ReprojView.valid = false;
+        m_Progress.reset();
+
+        double t0 = glfwGetTime();
+        renderFractalCpu();
+        m_CpuFractalTime = glfwGetTime() - t0;
+    }
+    else if (m_ComputeRendered) {
+        m_Symmetry         = FractalSymmetry();
+        m_Reprojection     = FractalReprojection();
+        m_ReprojView.valid = false;
+        m_Progress.reset();
+
+        m_FractalTimer->begin();
+        renderFractalCompute();
+        m_FractalTimer->end();
+    }
+    else if (m_Progressive) {
+        m_FractalTimer->begin();
+        renderFractalProgressive(m_Precision);
+        m_FractalTimer->end();
+    }
+    else {
+        // An unfinished field is not valid for reprojection
+        if (m_Progress.isActive()) {
+            m_Progress.reset();
+            m_ReprojView.valid = false;
+        }
+
+        m_FractalTimer->begin();
+        renderFractalGpu(m_Precision);
+        m_FractalTimer->end();
+    }
+
+    // ................................
+    // Post-process the fractal field
+    m_RenderGraph.importTarget("fractalField", getFractalField());
+    m_RenderGraph.setOutput("masterYUV", m_VideoRec.running);
+    m_RenderGraph.execute();
 
     // ................................
     // Geometry
@@ -1168,7 +2550,7 @@ int AcidbrotApp::loop (double dt) {
     // ................................
     // Copy the master framebuffer to the screen backbuffer
     {
-        GL::Framebuffer* fbMaster = m_Framebuffers.at("master").get();
+        GL::Framebuffer* fbMaster = m_RenderGraph.getTarget("master");
 
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
         glBindFramebuffer(GL_READ_FRAMEBUFFER, fbMaster->get());
@@ -1196,7 +2578,19 @@ int AcidbrotApp::loop (double dt) {
 
         // Frame rate
         GL_CHECK(glUniform4f(shaderProgram->getUniformLocation("color"), 1, 0, 0, 0.75f));
-        m_Fonts.at("generic")->drawText(2, viewport[3] - 16-2, "Frame rate: %.1f FPS", getFrameRate());
+        m_Fonts.at("generic")->drawText(2, viewport[3] - 16-2, stringf(
+            "Frame rate: %.1f FPS, %s%s%s%s%s%s%s%s%s%s", getFrameRate(),
+            getFractalPrecisionName(m_Precision),
+            m_AutoPrecision ? " (auto)" : "",
+            m_Exponent != 2 ? stringf(", z^%d", m_Exponent).c_str() : "",
+            m_Unroll > 1 ? stringf(", unrolled %dx", m_Unroll).c_str() : "",
+            m_Symmetry.enabled ? stringf(", %.0f%% mirrored", m_Symmetry.redundant * 100.0f).c_str() : "",
+            m_Reprojection.enabled ? ", reprojected" : "",
+            m_Reprojection.resume  ? ", resumed" : "",
+            m_Progress.isActive()  ? stringf(", %.0f%% progressive", m_Progress.getProgress() * 100.0f).c_str() : "",
+            m_Governor.getScale() < 1.0 ? stringf(", %.0f%% resolution", m_Governor.getScale() * 100.0).c_str() : "",
+            m_ComputeRendered ? ", compute" : ""
+            ));
 
         // Parameter
         if (m_CurrParam != m_Parameters.end()) {
@@ -1210,6 +2604,46 @@ int AcidbrotApp::loop (double dt) {
                           ));
         }
 
+        // CPU renderer
+        if (m_CpuRendered && m_TileCached) {
+            auto stats = m_TileCache->getStats();
+
+            GL_CHECK(glUniform4f(shaderProgram->getUniformLocation("color"), 1, 1, 0, 0.75f));
+            m_Fonts.at("generic")->drawText(2, viewport[3] - 48-2, stringf(
+                "CPU tile cache: %.0f%% cached, %zu tiles in memory, %zu on disk, %zu pending",
+                stats.hitRate * 100.0, stats.memory, stats.disk, stats.pending
+                ));
+        }
+        else if (m_CpuRendered) {
+            auto summary = m_CpuRenderer->getPool().getSummary();
+
+            GL_CHECK(glUniform4f(shaderProgram->getUniformLocation("color"), 1, 1, 0, 0.75f));
+            m_Fonts.at("generic")->drawText(2, viewport[3] - 48-2, stringf(
+                "CPU %s%s%s: %zu tiles (%.2f-%.2f ms), %zu stolen, balance %.0f%%, lanes %.0f%%, filled %.0f%%",
+                getCpuIsaName(m_CpuRenderer->getIsa()),
+                m_CpuRenderer->isRefilled() ? " refill" : "",
+                m_CpuRenderer->getSubdivide() ? " subdivide" : "",
+                summary.tiles, summary.minTime * 1e3, summary.maxTime * 1e3,
+                summary.stolen, summary.balance * 100.0,
+                m_CpuStats.getUtilization() * 100.0,
+                double(m_CpuStats.filled) / double(m_CpuField.size()) * 100.0
+                ));
+        }
+
+        // Deep zoom
+        if (m_Precision == FractalPrecision::Perturbation) {
+            std::string skipping = (m_UseBla || m_CpuRendered) ?
+                stringf("BLA %zu levels", m_Reference.bla.getLevelCount()) :
+                stringf("skipped %zu iter", m_Reference.series.getSkip());
+
+            GL_CHECK(glUniform4f(shaderProgram->getUniformLocation("color"), 1, 1, 0, 0.75f));
+            m_Fonts.at("generic")->drawText(2, viewport[3] - 48-2, stringf(
+                "Deep zoom: 2^%.1f, reference %zu iter, %s",
+                m_Viewport.position.zoom, m_Reference.orbit.getLength(),
+                skipping.c_str()
+                ));
+        }
+
 /*        GL_CHECK(glUniform4f(shaderProgram->getUniformLocation("color"), 1, 1, 1, 0.75f));
         m_Fonts.at("generic")->drawText(2, viewport[3] - 32-2, stringf("X:%.15f Y:%.15f Z:%.3f C:%.15f (%.15f, %.15f)",
             m_Viewport.position[0], m_Viewport.position[1], m_Viewport.position[2], m_Viewport.position[3], m_Viewport.position[4], m_Viewport.position[5]));
@@ -7,12 +7,29 @@
 #include <gl/texture.hh>
 #include <gl/texture3d.hh>
 #include <gl/framebuffer.hh>
+#include <gl/storage_buffer.hh>
+#include <gl/render_graph.hh>
 #include <gl/primitives.hh>
+#include <gl/timer_query.hh>
 
 #include "glfw_app.hh"
 #include "filter_mask.hh"
+#include "fractal_shaders.hh"
 #include "video_encoder.hh"
 
+#include "fractal/fractal.hh"
+#include "fractal/big_float.hh"
+#include "fractal/reference_orbit.hh"
+#include "fractal/series_approx.hh"
+#include "fractal/bla_table.hh"
+#include "fractal/cpu_renderer.hh"
+#include "fractal/precision_ladder.hh"
+#include "fractal/symmetry.hh"
+#include "fractal/reprojection.hh"
+#include "fractal/progressive.hh"
+#include "fractal/resolution_governor.hh"
+#include "fractal/tile_cache.hh"
+
 #include <vector>
 #include <array>
 #include <iostream>
@@ -38,6 +55,38 @@ protected:
         {1920, 1080}
     };
 
+    /// Reference orbit texture width
+    const size_t OrbitTextureWidth = 1024;
+    /// BLA table texture width
+    const size_t BlaTextureWidth   = 1024;
+    /// Maximum number of BLA table levels used by shaders
+    const size_t MaxBlaLevels      = 32;
+    /// Maximum number of taps of a filter mask pass used by shaders
+    const size_t MaxFilterTaps     = 64;
+    /// Time per frame for progressive fractal rendering, half of a 60 Hz
+    /// frame. The rest is left for post-processing and the overlay.
+    const double ProgressiveBudget = 0.5 / 60.0;
+    /// Speed of the view in pixels per second under which it stands still
+    const double MovingSpeed       = 2.0;
+    /// Memory budget of the fractal tile cache
+    const size_t TileCacheBudget   = 256 << 20;
+    /// Directory tiles evicted from the cache are spilled to
+    const char*  TileCacheDir      = "tile_cache";
+    /// Maximum number of compiled fractal shader variants
+    const size_t FractalShaderCacheSize = 16;
+    /// Iterations per dispatch of the compute shader fractal engine. Pixels
+    /// still iterating after it are compacted.
+    const int    ComputeChunk      = 256;
+    /// Persistent work groups of the compute shader fractal engine
+    const int    ComputeGroups     = 256;
+    /// Bits of the extended precision viewport position beyond those needed
+    /// to tell pixels apart. Keeps the motion and the reference orbit exact.
+    const size_t CenterGuardBits   = 64;
+    /// Deepest zoom with perturbation. The view geometry is in floatexp and
+    /// has no range limit, this bounds the precision of the reference orbit
+    /// and so its cost.
+    const double MaxDeepZoom       = 100000.0;
+
     /// The initialize method
     int initialize ();
     /// The loop method
@@ -47,6 +96,11 @@ protected:
 
     /// Initializes / Reinitializes framebuffers
     int initializeFramebuffers ();
+    /// Initializes / Reinitializes fractal field framebuffers
+    int initializeFractalFramebuffers ();
+    /// Declares the post-processing passes and their targets, separate or
+    /// fused ones
+    void initializeRenderGraph ();
 
     /// Keyboard callback
     void keyCallback (GLFWwindow* a_Window,
@@ -60,6 +114,18 @@ protected:
 
     /// Sets shader uniforms
     void setUniforms ();
+    /// Sets uniforms of a filter mask run in a single pass. Throws for
+    /// masks of more passes, the shader could not apply them.
+    void setFilterUniforms (GL::ShaderProgram* a_Shader, const std::string& a_Mask);
+    /// Sets uniforms of a pass of a filter mask
+    void setFilterUniforms (GL::ShaderProgram* a_Shader, FilterMask* a_Mask, size_t a_Pass);
+    /// Adds render graph passes applying a linear filter mask to a texture.
+    /// A separable mask runs as a horizontal and a vertical pass through an
+    /// intermediate target of its own.
+    void addFilterPasses (const std::string& a_Name,
+                          const std::string& a_Mask,
+                          const GL::RenderGraph::Input& a_Input,
+                          const std::string& a_Output);
 
     /// Saves a screenshot
     void takeScreenshot ();
@@ -71,6 +137,61 @@ protected:
     /// Records a video frame
     void recordFrame ();
 
+    /// Recomputes the reference orbit for deep zooming if needed
+    void updateReferenceOrbit ();
+    /// Checks the fractal for glitched pixels and picks a new reference
+    void checkGlitches ();
+    /// Computes series approximation coefficients for the view and the
+    /// number of iterations they skip
+    void updateSeriesApprox ();
+    /// Rebuilds the BLA table when the view no longer fits its offset bound
+    /// and uploads it to a texture
+    void updateBlaTable ();
+    /// Renders the fractal field on the CPU, from cached tiles if enabled,
+    /// and uploads it
+    void renderFractalCpu ();
+    /// Renders the fractal with the compute shader engine
+    void renderFractalCompute ();
+    /// Renders the fractal on the GPU with the given precision
+    void renderFractalGpu (FractalPrecision a_Precision);
+    /// Renders a part of the fractal on the GPU within the frame budget
+    void renderFractalProgressive (FractalPrecision a_Precision);
+    /// Starts a new fractal field on the GPU
+    void beginFractalGpu (FractalPrecision a_Precision);
+    /// Renders a rectangle of the fractal field
+    void drawFractalGpu (size_t a_X, size_t a_Y, size_t a_Width, size_t a_Height);
+    /// Completes the fractal field
+    void endFractalGpu ();
+    /// Returns the latest complete fractal field
+    GL::Framebuffer* getFractalField ();
+    /// Returns true if the view moves faster than MovingSpeed
+    bool isViewMoving ();
+    /// Adapts the fractal field resolution to the measured pass time
+    void updateResolution ();
+    /// Sets fractal symmetry uniforms of a shader
+    void setSymmetryUniforms (GL::ShaderProgram* a_Shader);
+    /// Fills in redundant pixels of a symmetric fractal
+    void renderMirror ();
+    /// Sets temporal reprojection uniforms of a shader, binds the previous
+    /// field to texture units 0 and 1
+    void setReprojectionUniforms (GL::ShaderProgram* a_Shader);
+    /// Returns parameters of the field of the current frame
+    FractalReprojection::View getReprojectionView ();
+
+    /// Returns the view scale 2^zoom. It is in floatexp as deep zooms take
+    /// it out of the double range.
+    FloatExp getViewScale ();
+    /// Returns the number of bits needed to tell pixels of the view apart
+    double getRequiredBits ();
+    /// Returns the precision of the extended precision viewport position
+    size_t getCenterBits ();
+    /// Returns the periodicity check distance, a fraction of a pixel
+    double getInteriorEpsilon ();
+    /// Selects the fractal precision for the current view
+    FractalPrecision selectPrecision ();
+    /// Measures relative costs of fractal shaders of all precisions
+    void benchmarkFractalShaders ();
+
     /// Updates the scene
     int updateScene (double dt);
     /// Renders the scene
@@ -83,25 +204,102 @@ protected:
 
     /// Screen quad
     std::unique_ptr<GL::ScreenQuad>  m_ScreenQuad;
+    /// Fractal pass GPU timer
+    std::unique_ptr<GL::TimerQuery>  m_FractalTimer;
 
     /// Fonts
     GL::Map<GL::Font>           m_Fonts;
     /// OpenGL shaders
     GL::Map<GL::ShaderProgram>  m_Shaders;
+    /// Fractal shader variants
+    std::unique_ptr<FractalShaderCache> m_FractalShaders;
     /// OpenGL textures
     GL::Map<GL::Texture>        m_Textures;
     /// OpenGL 3D textures
     GL::Map<GL::Texture3d>      m_Textures3d;
-    /// OpenGL framebuffers
+    /// OpenGL framebuffers of fractal fields
     GL::Map<GL::Framebuffer>    m_Framebuffers;
+    /// Post-processing passes, they own the full resolution framebuffers
+    GL::RenderGraph             m_RenderGraph;
+    /// OpenGL shader storage buffers
+    GL::Map<GL::StorageBuffer>  m_Buffers;
 
     /// FIR filter masks
     GL::Map<FilterMask>         m_Masks;
 
+    /// CPU fractal renderer
+    std::unique_ptr<CpuRenderer> m_CpuRenderer;
+    /// CPU rendered iteration count field and its encoded texels
+    std::vector<float>          m_CpuField;
+    std::vector<float>          m_CpuTexels;
+    /// CPU kernel stats of the last frame
+    CpuKernelStats              m_CpuStats;
+    /// Cache of CPU rendered fractal tiles
+    std::unique_ptr<TileCache>  m_TileCache;
+
+    /// Fractal precision selection
+    PrecisionLadder             m_Ladder;
+    /// Fractal precision selection of the CPU renderer
+    PrecisionLadder             m_CpuLadder;
+    /// Fractal precision of the current frame
+    FractalPrecision            m_Precision = FractalPrecision::Fp32;
+
     /// Screenshot flag
     bool m_DoScreenshot = false;
     /// Have fp64 shader extension
     bool m_HaveFp64 = false;
+    /// Have compute shaders (OpenGL 4.3)
+    bool m_HaveCompute = false;
+    /// Deep zoom (perturbation) mode enabled
+    bool m_DeepZoom = false;
+    /// Use BLA tables instead of series approximation in deep zoom mode
+    bool m_UseBla = false;
+    /// Render the fractal on the CPU
+    bool m_CpuRender = false;
+    /// Render the fractal with the compute shader engine where possible
+    bool m_UseCompute = false;
+    /// The last fractal field was rendered with the compute shader engine
+    bool m_ComputeRendered = false;
+    /// The last fractal field was rendered on the CPU
+    bool m_CpuRendered = false;
+    /// Composite the CPU rendered fractal from cached tiles
+    bool m_UseTileCache = false;
+    /// The last CPU fractal field was composited from cached tiles
+    bool m_TileCached = false;
+    /// Post-process with fused passes
+    bool m_FusedPostFx = false;
+    /// Blur the halo effect mask
+    bool m_HaloBlur = false;
+    /// Select the fractal precision automatically
+    bool m_AutoPrecision = true;
+    /// Enabled fractal interior checks, a mask of InteriorCheck flags
+    unsigned m_InteriorChecks = INTERIOR_ALL;
+    /// Fractal exponent, z^d + c
+    int m_Exponent = 2;
+    /// Fractal iterations per shader loop pass
+    int m_Unroll = 4;
+    /// Exploit fractal symmetry
+    bool m_UseSymmetry = true;
+    /// Fractal symmetry of the current frame
+    FractalSymmetry m_Symmetry;
+    /// Reproject the previous fractal field
+    bool m_UseReprojection = true;
+    /// Keep resumable iteration states of the fractal field
+    bool m_UseResume = true;
+    /// Reprojection of the current frame
+    FractalReprojection m_Reprojection;
+    /// Parameters of the previous fractal field
+    FractalReprojection::View m_ReprojView;
+    /// Render the fractal progressively
+    bool m_Progressive = false;
+    /// Progress of the fractal field
+    FractalProgress m_Progress;
+    /// Scale the fractal resolution dynamically
+    bool m_UseGovernor = true;
+    /// Fractal resolution governor
+    ResolutionGovernor m_Governor;
+    /// Fractal pass time on the CPU, negative if not measured
+    double m_CpuFractalTime = -1.0;
     /// VSync enabled
     bool m_EnableVSync = true;
 
@@ -127,10 +325,7 @@ protected:
     };
 
     /// Fractal type
-    enum class Fractal {
-        Mandelbrot,
-        Julia
-    };
+    typedef FractalType Fractal;
 
     /// Parameter
     struct Parameter {
@@ -158,9 +353,67 @@ protected:
         Viewport velocity;
     } m_Viewport;
 
+    /// Viewport position in arbitrary precision which follows the zoom. The
+    /// viewport position follows it rounded to a double.
+    std::array<BigFloat, 2> m_Center;
+
+    /// Deep zoom reference
+    struct {
+
+        /// The reference orbit
+        ReferenceOrbit orbit;
+        /// Series approximation for the current view
+        SeriesApprox   series;
+        /// BLA table
+        BlaTable       bla;
+        /// BLA table valid flag
+        bool   blaValid = false;
+        /// Bound of pixel offsets the BLA table was built for
+        FloatExp blaOffset;
+        /// Offsets of BLA table levels in the texture (in steps)
+        std::vector<GLint> blaOffsets;
+        /// Valid flag
+        bool   valid = false;
+        /// Reference point. Differs from the view center after re-referencing
+        std::array<BigFloat, 2> center;
+        /// Reference point moved away from the view center
+        bool   relocated = false;
+        /// Glitch check pending
+        bool   checkGlitches = false;
+        /// Re-referencing attempts for the current view
+        size_t attempts = 0;
+
+    } m_Reference;
+
     /// Fractal type
     Fractal m_Fractal = Fractal::Mandelbrot;
 
+    /// Parameters of the fractal field being rendered on the GPU
+    struct {
+
+        /// Precision
+        FractalPrecision precision = FractalPrecision::Fp32;
+        /// Fractal type
+        Fractal          type = Fractal::Mandelbrot;
+        /// Viewport position
+        Viewport         position;
+        /// Viewport position in arbitrary precision
+        std::array<BigFloat, 2> center;
+        /// Iteration limit
+        int              maxIter = 0;
+        /// Exponent
+        int              exponent = 2;
+        /// Enabled interior checks
+        unsigned         interior = 0;
+        /// Iterations per shader loop pass
+        int              unroll = 1;
+        /// Periodicity check distance
+        double           epsilon = 0.0;
+        /// Use the BLA table
+        bool             useBla = false;
+
+    } m_FractalJob;
+
     /// Parameters
     std::map<std::string, Parameter> m_Parameters;
     /// Current parameter
@@ -2,6 +2,11 @@
 
 #include <sys/types.h>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <utility>
+
 #include <cstdint>
 #include <cmath>
 #include <cstring>
@@ -15,11 +20,9 @@ FilterMask::FilterMask (size_t nx, size_t ny, size_t nc) :
 {
     // Allocate data
     m_Weights.resize(nx * ny * nc);
-    m_Offsets.resize(nx * ny);
 
     // Clear it
     memset(m_Weights.data(), 0, ny * nx * nc * sizeof(float));
-    memset(m_Offsets.data(), 0, ny * nx *      sizeof(Ofs));
 }
 
 // ============================================================================
@@ -70,85 +73,299 @@ void FilterMask::normalizeWeights () {
 
 void FilterMask::computeOffsets (size_t a_Width, size_t a_Height) {
 
-    // Compute sample offsets in texture coordinates given its size.
-    for (size_t j=0; j<m_Height; ++j) {
-        ssize_t jj = j - m_Height / 2;
+    // Offsets are computed in texture coordinates along with the passes
+    m_TextureWidth  = a_Width;
+    m_TextureHeight = a_Height;
+
+    m_Dirty = true;
+}
+
+void FilterMask::setSeparable (bool a_Enable) {
+    m_Separable = a_Enable;
+    m_Dirty     = true;
+}
+
+void FilterMask::setBilinearFolding (bool a_Enable) {
+    m_Folding = a_Enable;
+    m_Dirty   = true;
+}
+
+// ============================================================================
+
+bool FilterMask::decompose (std::vector<float>* a_Row, std::vector<float>* a_Column) const {
+
+    std::vector<float> row (m_Width  * m_Channels, 0.0f);
+    std::vector<float> col (m_Height * m_Channels, 0.0f);
+
+    for (size_t c=0; c<m_Channels; ++c) {
+
+        // Pivot on the largest weight
+        size_t pivot = 0;
+        float  max   = 0.0f;
+
+        for (size_t i=0; i<m_Width * m_Height; ++i) {
+            float w = fabs(m_Weights[i * m_Channels + c]);
+            if (w > max) {
+                max   = w;
+                pivot = i;
+            }
+        }
+
+        // All zero, the channel is zero in both passes
+        if (max == 0.0f) {
+            continue;
+        }
+
+        // The row and the column through the pivot. The column is scaled so
+        // that their product gives the pivot back.
+        size_t pi = pivot % m_Width;
+        size_t pj = pivot / m_Width;
+        float  pw = m_Weights[pivot * m_Channels + c];
+
         for (size_t i=0; i<m_Width; ++i) {
-            ssize_t ii  = i - m_Width / 2;
-            size_t  idx = j * m_Width + i;
+            row[i * m_Channels + c] = m_Weights[(pj * m_Width + i) * m_Channels + c];
+        }
+        for (size_t j=0; j<m_Height; ++j) {
+            col[j * m_Channels + c] = m_Weights[(j * m_Width + pi) * m_Channels + c] / pw;
+        }
 
-            m_Offsets[idx].x = ((float)ii + 0.5f) / (float)a_Width;
-            m_Offsets[idx].y = ((float)jj + 0.5f) / (float)a_Height;
+        // Their product has to give all the weights
+        float tolerance = 1e-5f * max;
+        for (size_t j=0; j<m_Height; ++j) {
+            for (size_t i=0; i<m_Width; ++i) {
+                float w = m_Weights[(j * m_Width + i) * m_Channels + c];
+                float p = col[j * m_Channels + c] * row[i * m_Channels + c];
+
+                if (fabs(w - p) > tolerance) {
+                    return false;
+                }
+            }
         }
     }
 
-    m_Dirty = true;
+    if (a_Row != nullptr) {
+        *a_Row = row;
+    }
+    if (a_Column != nullptr) {
+        *a_Column = col;
+    }
+
+    return true;
+}
+
+bool FilterMask::isSeparable () const {
+    return decompose(nullptr, nullptr);
 }
 
 // ============================================================================
 
-void FilterMask::prepareDataForShader () {
-    size_t N = m_Width * m_Height;
+FilterMask::Pass FilterMask::makePass (const std::vector<float>& a_Weights,
+                                       size_t nx, size_t ny,
+                                       bool a_ShiftX, bool a_ShiftY) const
+{
+    float shiftX = a_ShiftX ? 0.5f : 0.0f;
+    float shiftY = a_ShiftY ? 0.5f : 0.0f;
+
+    // Taps as they are, discarding weights of value 0.0 for all channels
+    Pass dense;
+    for (size_t j=0; j<ny; ++j) {
+        ssize_t jj = j - ny / 2;
+        for (size_t i=0; i<nx; ++i) {
+            ssize_t ii  = i - nx / 2;
+            size_t  idx = (j * nx + i) * m_Channels;
+
+            auto first = a_Weights.begin() + idx;
+            auto last  = first + m_Channels;
+            if (std::all_of(first, last, [](float w) {return w == 0.0f;})) {
+                continue;
+            }
+
+            dense.weights.insert(dense.weights.end(), first, last);
+            dense.offsets.push_back(Ofs{
+                ((float)ii + shiftX) / (float)m_TextureWidth,
+                ((float)jj + shiftY) / (float)m_TextureHeight
+            });
+        }
+    }
 
-    m_WeightsForShader.clear();
-    m_OffsetsForShader.clear();
+    if (!m_Folding) {
+        return dense;
+    }
 
-    std::vector<float> weightVec(m_Channels);
+    // A tap shifted by half a texel averages two texels per axis. Spread
+    // taps to the texels they sample, keyed by row and column or by column
+    // and row so that taps to fold are next to each other.
+    bool alongY = (nx == 1 && !a_ShiftX);
 
-    // Process all spatial offsets
-    for (size_t i=0; i<N; ++i) {
-        bool useWeight = false;
+    typedef std::pair<ssize_t, ssize_t> Key;
+    std::map<Key, std::vector<float>> texels;
+
+    for (size_t j=0; j<ny; ++j) {
+        ssize_t jj = j - ny / 2;
+        for (size_t i=0; i<nx; ++i) {
+            ssize_t ii  = i - nx / 2;
+            size_t  idx = (j * nx + i) * m_Channels;
 
-        // Collect weights among all channels for the given spatial location
+            for (ssize_t dy=0; dy<=(a_ShiftY ? 1 : 0); ++dy) {
+                for (ssize_t dx=0; dx<=(a_ShiftX ? 1 : 0); ++dx) {
+                    float scale = (a_ShiftX ? 0.5f : 1.0f) * (a_ShiftY ? 0.5f : 1.0f);
+
+                    Key key = alongY ? Key(ii + dx, jj + dy) : Key(jj + dy, ii + dx);
+                    auto& texel = texels[key];
+                    texel.resize(m_Channels, 0.0f);
+
+                    for (size_t c=0; c<m_Channels; ++c) {
+                        texel[c] += a_Weights[idx + c] * scale;
+                    }
+                }
+            }
+        }
+    }
+
+    // Fold pairs of adjacent texels. A fetch at a fraction t between them
+    // weights them (1-t) and t, which has to be the same for all channels.
+    auto fold = [&](const std::vector<float>& a_First, const std::vector<float>& a_Second,
+                    float* a_Fraction)
+    {
+        bool found = false;
         for (size_t c=0; c<m_Channels; ++c) {
-            float w = m_Weights[i * m_Channels + c];
-            weightVec[c] = w;
+            float w0 = a_First[c];
+            float w1 = a_Second[c];
 
-            if (w != 0.0f) {
-                useWeight = true;
+            if (w0 == 0.0f && w1 == 0.0f) {
+                continue;
             }
+            if (w0 * w1 < 0.0f) {
+                return false;
+            }
+
+            float t = w1 / (w0 + w1);
+            if (found && fabs(t - *a_Fraction) > 1e-6f) {
+                return false;
+            }
+
+            *a_Fraction = t;
+            found = true;
         }
 
-        // Do not use this weights. Its 0 for all channels
-        if (!useWeight) {
+        return found;
+    };
+
+    Pass folded;
+    for (auto it = texels.begin(); it != texels.end(); ++it) {
+        const Key&                key     = it->first;
+        const std::vector<float>* weights = &it->second;
+
+        if (std::all_of(weights->begin(), weights->end(), [](float w) {return w == 0.0f;})) {
             continue;
         }
 
-        // Store data
-        m_WeightsForShader.insert(m_WeightsForShader.end(),
-            weightVec.begin(), weightVec.end());
+        float fraction = 0.0f;
+        std::vector<float> sum;
+
+        auto next = std::next(it);
+        if (next != texels.end() &&
+            next->first.first  == key.first &&
+            next->first.second == key.second + 1 &&
+            fold(*weights, next->second, &fraction))
+        {
+            sum = *weights;
+            for (size_t c=0; c<m_Channels; ++c) {
+                sum[c] += next->second[c];
+            }
+
+            weights = &sum;
+            it      = next;
+        }
+
+        float minor = (float)key.second + fraction;
+        float major = (float)key.first;
+
+        folded.weights.insert(folded.weights.end(), weights->begin(), weights->end());
+        folded.offsets.push_back(alongY ?
+            Ofs{major / (float)m_TextureWidth, minor / (float)m_TextureHeight} :
+            Ofs{minor / (float)m_TextureWidth, major / (float)m_TextureHeight}
+        );
+    }
+
+    // Spreading taps to texels adds fetches where little folds
+    return (folded.offsets.size() < dense.offsets.size()) ? folded : dense;
+}
+
+void FilterMask::prepareDataForShader () {
+
+    m_Passes.clear();
+
+    // Dense
+    Pass dense = makePass(m_Weights, m_Width, m_Height, true, true);
 
-        // Store offset
-        m_OffsetsForShader.push_back(m_Offsets[i]);
+    // Separable, a horizontal and a vertical pass. Used when they take fewer
+    // fetches together.
+    std::vector<float> row;
+    std::vector<float> col;
+
+    if (m_Separable && decompose(&row, &col)) {
+        Pass horizontal = makePass(row, m_Width, 1, true, false);
+        Pass vertical   = makePass(col, 1, m_Height, false, true);
+
+        if (horizontal.offsets.size() + vertical.offsets.size() < dense.offsets.size()) {
+            m_Passes.push_back(horizontal);
+            m_Passes.push_back(vertical);
+        }
+    }
+
+    if (m_Passes.empty()) {
+        m_Passes.push_back(dense);
     }
 
     m_Dirty = false;
 }
 
-size_t FilterMask::getCountForShader () {
+size_t FilterMask::getPassCount () {
 
     if (m_Dirty) {
         prepareDataForShader();
     }
 
-    return m_OffsetsForShader.size();
+    return m_Passes.size();
 }
 
-const float* FilterMask::getWeightsForShader () {
+size_t FilterMask::getCountForShader (size_t a_Pass) {
 
     if (m_Dirty) {
         prepareDataForShader();
     }
 
-    return m_WeightsForShader.data();
+    if (a_Pass >= m_Passes.size()) {
+        return 0;
+    }
+
+    return m_Passes[a_Pass].offsets.size();
 }
 
-const float* FilterMask::getOffsetsForShader () {
+const float* FilterMask::getWeightsForShader (size_t a_Pass) {
 
     if (m_Dirty) {
         prepareDataForShader();
     }
 
-    return (float*)m_OffsetsForShader.data();
+    if (a_Pass >= m_Passes.size()) {
+        return nullptr;
+    }
+
+    return m_Passes[a_Pass].weights.data();
+}
+
+const float* FilterMask::getOffsetsForShader (size_t a_Pass) {
+
+    if (m_Dirty) {
+        prepareDataForShader();
+    }
+
+    if (a_Pass >= m_Passes.size()) {
+        return nullptr;
+    }
+
+    return (float*)m_Passes[a_Pass].offsets.data();
 }
 
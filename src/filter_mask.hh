@@ -8,6 +8,21 @@
 
 // ============================================================================
 
+/// A FIR filter mask. Taps are placed half a texel off the pixel center so
+/// with linear texture filtering every tap averages four texels.
+///
+/// Masks are given to shaders as one dense list of taps by default. Two
+/// options trade that for fewer texture fetches:
+///
+///  - Separable masks (each channel an outer product of a row and a column)
+///    run as two 1D passes, horizontal and vertical, through an
+///    intermediate texture. That is O(n) fetches instead of O(n^2).
+///  - Bilinear folding merges pairs of adjacent texels of the same sign into
+///    single fetches between them. It needs a linearly filtered texture of
+///    the size given to computeOffsets() whose samples are summed linearly.
+///
+/// Both reproduce the dense mask up to the precision of the texture unit
+/// and the intermediate texture.
 class FilterMask
 {
 public:
@@ -23,12 +38,23 @@ public:
     /// Computes offsets for given texture size
     void computeOffsets (size_t a_Width, size_t a_Height);
 
-    /// Returns weight and offset count for shader
-    size_t       getCountForShader   ();
-    /// Returns the weights vector for shader
-    const float* getWeightsForShader ();
-    /// Returns the offsets vector for shader
-    const float* getOffsetsForShader ();
+    /// Runs separable masks as two 1D passes
+    void setSeparable       (bool a_Enable);
+    /// Merges adjacent taps into bilinear fetches where it saves fetches
+    void setBilinearFolding (bool a_Enable);
+
+    /// Returns true when each channel is an outer product of a row and a
+    /// column
+    bool isSeparable () const;
+
+    /// Returns the number of passes, two for a separable mask run as such
+    size_t       getPassCount        ();
+    /// Returns weight and offset count of a pass for shader
+    size_t       getCountForShader   (size_t a_Pass = 0);
+    /// Returns the weights vector of a pass for shader
+    const float* getWeightsForShader (size_t a_Pass = 0);
+    /// Returns the offsets vector of a pass for shader
+    const float* getOffsetsForShader (size_t a_Pass = 0);
 
 protected:
 
@@ -38,27 +64,46 @@ protected:
         float y;
     };
 
+    /// Taps of a pass for shader
+    struct Pass {
+        std::vector<float>  weights;
+        std::vector<Ofs>    offsets;
+    };
+
     /// Dimensions
     size_t  m_Width;
     size_t  m_Height;
     /// Channel count
     size_t  m_Channels;
 
+    /// Texture size the offsets are computed for
+    size_t  m_TextureWidth  = 1;
+    size_t  m_TextureHeight = 1;
+
+    /// Options
+    bool    m_Separable = false;
+    bool    m_Folding   = false;
+
     /// Dirty flag
     bool    m_Dirty = true;
 
     /// Weights
     std::vector<float>  m_Weights;
-    /// Offsets
-    std::vector<Ofs>    m_Offsets;
 
-    /// Weights for shader
-    std::vector<float>  m_WeightsForShader;
-    /// Offsets for shader
-    std::vector<Ofs>    m_OffsetsForShader;
+    /// Passes for shader
+    std::vector<Pass>   m_Passes;
+
+    /// Splits weights of each channel into a row and a column. Returns false
+    /// if the mask is not separable.
+    bool decompose (std::vector<float>* a_Row, std::vector<float>* a_Column) const;
+
+    /// Makes a pass of an nx by ny mask whose taps are shifted by half a
+    /// texel along the flagged axes. Taps of value 0.0 for all channels are
+    /// discarded, the rest are folded if enabled and it saves fetches.
+    Pass makePass (const std::vector<float>& a_Weights, size_t nx, size_t ny,
+                   bool a_ShiftX, bool a_ShiftY) const;
 
-    /// Prepares weights for the shader by discarding weights of value 0.0 for
-    /// all channels
+    /// Prepares passes for the shader
     void prepareDataForShader ();
 };
 
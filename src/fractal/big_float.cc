@@ -0,0 +1,489 @@
+#include "big_float.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// ============================================================================
+
+typedef BigFloat::Limb Limb;
+typedef BigFloat::Wide Wide;
+
+static constexpr size_t LB = BigFloat::LIMB_BITS;
+
+/// Returns the number of leading zero bits of a non-zero limb
+static inline int countLeadingZeros (Limb a) {
+    return (sizeof(Limb) == sizeof(unsigned long long)) ? __builtin_clzll(a) :
+                                                          __builtin_clz(unsigned(a));
+}
+
+/// Returns the number of limbs for a precision
+static inline size_t getLimbCount (size_t a_Bits) {
+    return std::max((a_Bits + LB - 1) / LB, size_t(1));
+}
+
+/// Scratch space of the arithmetic, avoids allocations in loops
+static thread_local std::vector<Limb> s_Scratch;
+
+static Limb* getScratch (size_t a_Size) {
+    if (s_Scratch.size() < a_Size) {
+        s_Scratch.resize(a_Size);
+    }
+    return s_Scratch.data();
+}
+
+/// Shifts an n+1 limb number left so that its most significant bit is set.
+/// Returns the shift, zero for zero.
+static int64_t normalizeLeft (Limb* a, size_t n) {
+
+    // Already normalized
+    if ((a[n] >> (LB - 1)) != 0) {
+        return 0;
+    }
+
+    size_t top = n + 1;
+    while (top > 0 && a[top - 1] == 0) {
+        top--;
+    }
+
+    if (top == 0) {
+        return 0;
+    }
+
+    size_t q = n + 1 - top;
+    int    s = countLeadingZeros(a[top - 1]);
+
+    // Cancellation of a few bits only, the common case of subtractions
+    if (q == 0) {
+        for (size_t i=n; i>0; --i) {
+            a[i] = (a[i] << s) | (a[i - 1] >> (LB - s));
+        }
+        a[0] <<= s;
+        return s;
+    }
+
+    for (size_t i=n+1; i-- > 0; ) {
+        Limb hi = (i >= q)     ? a[i - q]     : 0;
+        Limb lo = (i >= q + 1) ? a[i - q - 1] : 0;
+        a[i] = s ? (hi << s) | (lo >> (LB - s)) : hi;
+    }
+
+    return int64_t(q * LB) + s;
+}
+
+/// Adds two limbs and a carry, returns the carry out. Compiles to a chain of
+/// add with carry instructions where they are available.
+static inline unsigned char addCarry (Limb a, Limb b, unsigned char a_Carry, Limb* r) {
+#if defined(__x86_64__)
+    unsigned long long sum;
+    unsigned char carry = _addcarry_u64(a_Carry, a, b, &sum);
+    *r = Limb(sum);
+    return carry;
+#else
+    Wide sum = Wide(a) + b + a_Carry;
+    *r = Limb(sum);
+    return (unsigned char)(sum >> LB);
+#endif
+}
+
+/// Subtracts a limb and a borrow from a limb, returns the borrow out
+static inline unsigned char subBorrow (Limb a, Limb b, unsigned char a_Borrow, Limb* r) {
+#if defined(__x86_64__)
+    unsigned long long diff;
+    unsigned char borrow = _subborrow_u64(a_Borrow, a, b, &diff);
+    *r = Limb(diff);
+    return borrow;
+#else
+    Wide diff = Wide(a) - b - a_Borrow;
+    *r = Limb(diff);
+    return (unsigned char)(diff >> LB) & 1;
+#endif
+}
+
+/// Returns a limb of a number shifted right by s bits, s < LB, from the
+/// limb and the one above it. The left shift is split so that s = 0 gives
+/// the limb itself.
+static inline Limb shiftRight (const Limb* a, int s) {
+    return (a[0] >> s) | ((a[1] << 1) << (LB - 1 - s));
+}
+
+// ============================================================================
+
+BigFloat::BigFloat (double a_Value, size_t a_Bits) :
+    m_Limbs(getLimbCount(a_Bits), 0)
+{
+    if (a_Value == 0.0 || !std::isfinite(a_Value)) {
+        return;
+    }
+
+    m_Negative = (a_Value < 0.0);
+
+    int    e;
+    double m = std::frexp(std::fabs(a_Value), &e);
+    m_Exponent = e;
+
+    // The mantissa in [0.5, 1) is exact in a few limbs
+    for (size_t i=m_Limbs.size(); i-- > 0 && m != 0.0; ) {
+        m = std::ldexp(m, int(LB));
+        double limb = std::floor(m);
+        m_Limbs[i] = Limb(limb);
+        m -= limb;
+    }
+}
+
+// ============================================================================
+
+size_t BigFloat::getBits () const {
+    return m_Limbs.size() * LB;
+}
+
+void BigFloat::setBits (size_t a_Bits) {
+    size_t n = getLimbCount(a_Bits);
+    size_t m = m_Limbs.size();
+
+    // Limbs are added or dropped at the least significant end
+    if (n > m) {
+        m_Limbs.insert(m_Limbs.begin(), n - m, 0);
+    }
+    else if (n < m) {
+        m_Limbs.erase(m_Limbs.begin(), m_Limbs.begin() + (m - n));
+    }
+}
+
+bool BigFloat::isZero () const {
+    return m_Limbs.back() == 0;
+}
+
+bool BigFloat::isNegative () const {
+    return m_Negative && !isZero();
+}
+
+int64_t BigFloat::getExponent () const {
+    return m_Exponent;
+}
+
+// ============================================================================
+
+BigFloat::operator double () const {
+
+    if (isZero()) {
+        return 0.0;
+    }
+
+    // Limbs below the double precision do not matter
+    double m = 0.0;
+    size_t n = m_Limbs.size();
+    size_t k = std::min(n, size_t(128 / LB));
+
+    for (size_t i=n-k; i<n; ++i) {
+        m = std::ldexp(m, -int(LB)) + std::ldexp(double(m_Limbs[i]), -int(LB));
+    }
+
+    // Exponents out of the int range are out of the double range as well
+    int64_t e = std::max(std::min(m_Exponent, int64_t(1 << 20)), int64_t(-(1 << 20)));
+    m = std::ldexp(m, int(e));
+
+    return m_Negative ? -m : m;
+}
+
+// ============================================================================
+
+int BigFloat::compareMagnitudes (const BigFloat& a, const BigFloat& b) {
+
+    if (a.isZero() || b.isZero()) {
+        return int(!a.isZero()) - int(!b.isZero());
+    }
+
+    if (a.m_Exponent != b.m_Exponent) {
+        return (a.m_Exponent > b.m_Exponent) ? 1 : -1;
+    }
+
+    for (size_t i=a.m_Limbs.size(); i-- > 0; ) {
+        if (a.m_Limbs[i] != b.m_Limbs[i]) {
+            return (a.m_Limbs[i] > b.m_Limbs[i]) ? 1 : -1;
+        }
+    }
+
+    return 0;
+}
+
+void BigFloat::addMagnitudes (BigFloat& r, const BigFloat& a, const BigFloat& b, bool a_Subtract) {
+
+    const size_t n = a.m_Limbs.size();
+    const Limb*  x = a.m_Limbs.data();
+    const Limb*  y = b.m_Limbs.data();
+
+    // Work with a guard limb below the mantissas. The smaller operand is
+    // aligned to the larger one as it is added.
+    Limb* t = getScratch(2 * (n + 2));
+    Limb* v = t + (n + 2);
+
+    uint64_t d = b.isZero() ? UINT64_MAX : uint64_t(a.m_Exponent - b.m_Exponent);
+    size_t   q = (d / LB > n + 1) ? n + 1 : size_t(d / LB);
+    int      s = int(d % LB);
+
+    // The smaller mantissa with a zero limb at both ends, so that the shift
+    // needs no bound checks
+    v[0]     = 0;
+    v[n + 1] = 0;
+    std::memcpy(v + 1, y, n * sizeof(Limb));
+
+    // Limbs of the shifted mantissa that are not all zeros
+    size_t m = (q <= n) ? n - q + 1 : 0;
+    Limb   u = (m > 0) ? shiftRight(v + q, s) : 0;
+
+    int64_t exponent = a.m_Exponent;
+
+    if (!a_Subtract) {
+        unsigned char carry = 0;
+        size_t i = 1;
+
+        t[0] = u;
+        for (; i<m; ++i) {
+            carry = addCarry(x[i - 1], shiftRight(v + q + i, s), carry, t + i);
+        }
+        for (; i<=n; ++i) {
+            carry = addCarry(x[i - 1], 0, carry, t + i);
+        }
+
+        // Overflow, shift right by one
+        if (carry) {
+            for (size_t i=0; i<n; ++i) {
+                t[i] = (t[i] >> 1) | (t[i + 1] << (LB - 1));
+            }
+            t[n] = (t[n] >> 1) | (Limb(1) << (LB - 1));
+            exponent++;
+        }
+    }
+    else {
+        unsigned char borrow = (u != 0);
+        size_t i = 1;
+
+        t[0] = Limb(0) - u;
+        for (; i<m; ++i) {
+            borrow = subBorrow(x[i - 1], shiftRight(v + q + i, s), borrow, t + i);
+        }
+        for (; i<=n; ++i) {
+            borrow = subBorrow(x[i - 1], 0, borrow, t + i);
+        }
+
+        int64_t shift = normalizeLeft(t, n);
+        if (t[n] == 0) {
+            std::fill(r.m_Limbs.begin(), r.m_Limbs.end(), 0);
+            r.m_Exponent = 0;
+            r.m_Negative = false;
+            return;
+        }
+
+        exponent -= shift;
+    }
+
+    std::memcpy(r.m_Limbs.data(), t + 1, n * sizeof(Limb));
+    r.m_Exponent = exponent;
+}
+
+void BigFloat::add (BigFloat& r, const BigFloat& a, const BigFloat& b) {
+
+    // The larger magnitude first, it gives the sign
+    const BigFloat& x = (compareMagnitudes(a, b) >= 0) ? a : b;
+    const BigFloat& y = (&x == &a) ? b : a;
+
+    if (x.isZero()) {
+        r = x;
+        return;
+    }
+
+    bool negative = x.m_Negative;
+    addMagnitudes(r, x, y, x.m_Negative != y.m_Negative);
+    r.m_Negative = negative && !r.isZero();
+}
+
+void BigFloat::sub (BigFloat& r, const BigFloat& a, const BigFloat& b) {
+
+    // a - b = a + (-b) without copying b
+    const bool aFirst = (compareMagnitudes(a, b) >= 0);
+    const BigFloat& x = aFirst ? a : b;
+    const BigFloat& y = aFirst ? b : a;
+
+    if (x.isZero()) {
+        r = x;
+        return;
+    }
+
+    bool negative = aFirst ? a.m_Negative : !b.m_Negative;
+    addMagnitudes(r, x, y, a.m_Negative == b.m_Negative);
+    r.m_Negative = negative && !r.isZero();
+}
+
+// ============================================================================
+
+void BigFloat::storeProduct (BigFloat& r, const Limb* a_Product, int64_t a_Exponent, bool a_Negative) {
+
+    const size_t n = r.m_Limbs.size();
+    const Limb*  p = a_Product;
+
+    // The product of two mantissas in [0.5, 1) is in [0.25, 1), at most one
+    // bit of shift is needed
+    if ((p[n] >> (LB - 1)) == 0) {
+        for (size_t i=n; i>0; --i) {
+            r.m_Limbs[i - 1] = (p[i] << 1) | (p[i - 1] >> (LB - 1));
+        }
+        a_Exponent--;
+    }
+    else {
+        std::memcpy(r.m_Limbs.data(), p + 1, n * sizeof(Limb));
+    }
+
+    r.m_Exponent = a_Exponent;
+    r.m_Negative = a_Negative;
+}
+
+void BigFloat::mul (BigFloat& r, const BigFloat& a, const BigFloat& b) {
+
+    if (a.isZero() || b.isZero()) {
+        std::fill(r.m_Limbs.begin(), r.m_Limbs.end(), 0);
+        r.m_Exponent = 0;
+        r.m_Negative = false;
+        return;
+    }
+
+    const size_t n = a.m_Limbs.size();
+    const Limb*  x = a.m_Limbs.data();
+    const Limb*  y = b.m_Limbs.data();
+
+    // Columns of the 2n limb product from k0 = n-2 up. The lower columns
+    // change the result by less than n/2^LB of its last limb.
+    size_t k0 = (n >= 2) ? n - 2 : 0;
+    Limb*  c  = getScratch(2 * n - k0);
+
+    // The carry into the next column, below n limbs. The low and the high
+    // limbs of the products are summed apart, neither sum can overflow
+    // two limbs so there is no carry to detect in the inner loop.
+    Wide acc = 0;
+
+    for (size_t k=k0; k<2*n-1; ++k) {
+        size_t i0 = (k >= n) ? k - (n - 1) : 0;
+        size_t i1 = std::min(k, n - 1);
+
+        Wide lo = 0;
+        Wide hi = 0;
+
+        for (size_t i=i0; i<=i1; ++i) {
+            Wide p = Wide(x[i]) * y[k - i];
+            lo += Limb(p);
+            hi += Limb(p >> LB);
+        }
+
+        acc += lo;
+        c[k - k0] = Limb(acc);
+        acc = (acc >> LB) + hi;
+    }
+
+    c[2 * n - 1 - k0] = Limb(acc);
+
+    // The product limbs n-1..2n-1
+    storeProduct(r, c + (n - 1 - k0), a.m_Exponent + b.m_Exponent, a.m_Negative != b.m_Negative);
+}
+
+void BigFloat::sqr (BigFloat& r, const BigFloat& a) {
+
+    if (a.isZero()) {
+        std::fill(r.m_Limbs.begin(), r.m_Limbs.end(), 0);
+        r.m_Exponent = 0;
+        r.m_Negative = false;
+        return;
+    }
+
+    const size_t n = a.m_Limbs.size();
+    const Limb*  x = a.m_Limbs.data();
+
+    // Columns as for mul. A product off the diagonal appears twice in its
+    // column, it is summed once and the sums are doubled.
+    size_t k0 = (n >= 2) ? n - 2 : 0;
+    Limb*  c  = getScratch(2 * n - k0);
+
+    Wide acc = 0;
+
+    for (size_t k=k0; k<2*n-1; ++k) {
+        size_t i0 = (k >= n) ? k - (n - 1) : 0;
+        size_t i1 = (k + 1) / 2;
+
+        // Products x[i] * x[k-i] for i < k-i
+        Wide lo = 0;
+        Wide hi = 0;
+
+        for (size_t i=i0; i<i1; ++i) {
+            Wide p = Wide(x[i]) * x[k - i];
+            lo += Limb(p);
+            hi += Limb(p >> LB);
+        }
+
+        lo <<= 1;
+        hi <<= 1;
+
+        // The diagonal
+        if ((k & 1) == 0) {
+            Wide p = Wide(x[k / 2]) * x[k / 2];
+            lo += Limb(p);
+            hi += Limb(p >> LB);
+        }
+
+        acc += lo;
+        c[k - k0] = Limb(acc);
+        acc = (acc >> LB) + hi;
+    }
+
+    c[2 * n - 1 - k0] = Limb(acc);
+
+    storeProduct(r, c + (n - 1 - k0), 2 * a.m_Exponent, false);
+}
+
+// ============================================================================
+
+BigFloat ldexp (const BigFloat& a, int64_t e) {
+    BigFloat r = a;
+    if (!r.isZero()) {
+        r.m_Exponent += e;
+    }
+    return r;
+}
+
+BigFloat operator - (const BigFloat& a) {
+    BigFloat r = a;
+    r.m_Negative = !r.m_Negative;
+    return r;
+}
+
+/// Returns copies of the operands with the larger precision
+static inline void promote (const BigFloat& a, const BigFloat& b, BigFloat* x, BigFloat* y) {
+    size_t bits = std::max(a.getBits(), b.getBits());
+    *x = a;
+    *y = b;
+    x->setBits(bits);
+    y->setBits(bits);
+}
+
+BigFloat operator + (const BigFloat& a, const BigFloat& b) {
+    BigFloat x, y;
+    promote(a, b, &x, &y);
+    BigFloat::add(x, x, y);
+    return x;
+}
+
+BigFloat operator - (const BigFloat& a, const BigFloat& b) {
+    BigFloat x, y;
+    promote(a, b, &x, &y);
+    BigFloat::sub(x, x, y);
+    return x;
+}
+
+BigFloat operator * (const BigFloat& a, const BigFloat& b) {
+    BigFloat x, y;
+    promote(a, b, &x, &y);
+    BigFloat::mul(x, x, y);
+    return x;
+}
@@ -0,0 +1,102 @@
+#ifndef FRACTAL_BIG_FLOAT_HH
+#define FRACTAL_BIG_FLOAT_HH
+
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+
+/// An arbitrary precision binary floating point number. The mantissa is a
+/// vector of limbs, the least significant first, with the most significant
+/// bit set. The value is
+///
+///  (-1)^sign * 0.mantissa * 2^exponent
+///
+/// The precision is a whole number of limbs and is chosen by the user, it
+/// is meant to follow the zoom level. Results get the precision of the
+/// destination for the in-place functions and the larger one of the operands
+/// for the operators. Results are truncated, not rounded.
+///
+/// Products are short products: only the limb products that affect the
+/// result are summed, which is about a half of them for multiplication and
+/// a quarter for squaring. They are summed column by column in registers.
+/// Squaring is preferred where possible.
+class BigFloat
+{
+public:
+
+#if defined(__SIZEOF_INT128__)
+    typedef uint64_t          Limb;
+    typedef unsigned __int128 Wide;
+#else
+    typedef uint32_t          Limb;
+    typedef uint64_t          Wide;
+#endif
+
+    /// Bits per limb
+    static constexpr size_t LIMB_BITS = 8 * sizeof(Limb);
+    /// Default precision, enough for a double-double
+    static constexpr size_t DEFAULT_BITS = 128;
+
+    /// Zero
+    BigFloat () : BigFloat(0.0) {};
+    /// Conversion from a double
+    BigFloat (double a_Value, size_t a_Bits = DEFAULT_BITS);
+
+    /// Returns the precision in bits
+    size_t  getBits     () const;
+    /// Sets the precision, rounded up to whole limbs. The value is
+    /// truncated or extended with zeros.
+    void    setBits     (size_t a_Bits);
+
+    /// Returns true for zero
+    bool    isZero      () const;
+    /// Returns true for negative numbers
+    bool    isNegative  () const;
+    /// Returns the exponent, the value is in [2^(e-1), 2^e) in magnitude
+    int64_t getExponent () const;
+
+    /// Conversion to double. Values out of the double range become zero or
+    /// infinity.
+    explicit operator double () const;
+
+    /// In-place arithmetic. The result may alias the operands, all the
+    /// numbers must have the same precision.
+    static void add (BigFloat& r, const BigFloat& a, const BigFloat& b);
+    static void sub (BigFloat& r, const BigFloat& a, const BigFloat& b);
+    static void mul (BigFloat& r, const BigFloat& a, const BigFloat& b);
+    static void sqr (BigFloat& r, const BigFloat& a);
+
+    /// Multiplication by a power of two (exact)
+    friend BigFloat ldexp (const BigFloat& a, int64_t e);
+    /// Negation
+    friend BigFloat operator - (const BigFloat& a);
+
+protected:
+
+    /// Adds or subtracts magnitudes, |a| >= |b|
+    static void addMagnitudes (BigFloat& r, const BigFloat& a, const BigFloat& b, bool a_Subtract);
+    /// Compares magnitudes
+    static int  compareMagnitudes (const BigFloat& a, const BigFloat& b);
+    /// Normalizes a product of the top n+1 limbs of a 2n limb product
+    static void storeProduct (BigFloat& r, const Limb* a_Product, int64_t a_Exponent, bool a_Negative);
+
+    /// Mantissa, the least significant limb first
+    std::vector<Limb> m_Limbs;
+    /// Exponent
+    int64_t           m_Exponent = 0;
+    /// Sign
+    bool              m_Negative = false;
+};
+
+// ============================================================================
+
+/// Arithmetic. Operands of different precisions are extended to the larger
+/// one.
+BigFloat operator + (const BigFloat& a, const BigFloat& b);
+BigFloat operator - (const BigFloat& a, const BigFloat& b);
+BigFloat operator * (const BigFloat& a, const BigFloat& b);
+
+#endif // FRACTAL_BIG_FLOAT_HH
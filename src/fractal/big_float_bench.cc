@@ -0,0 +1,95 @@
+#include "big_float_bench.hh"
+#include "big_float.hh"
+#include "reference_orbit.hh"
+
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+/// Precisions of the operation benchmark, in bits
+static const size_t s_Precisions[] = {128, 256, 512, 1024, 2048, 3456, 8192};
+
+/// Returns a number with all the mantissa bits used
+static BigFloat makeNumber (double a_Value, size_t a_Bits) {
+
+    BigFloat value (a_Value, a_Bits);
+    for (size_t i=53; i<a_Bits; i+=53) {
+        value = value + ldexp(BigFloat(sin(double(i)), a_Bits), -int64_t(i));
+    }
+
+    value.setBits(a_Bits);
+    return value;
+}
+
+/// Runs an operation and returns the best time per call of several runs
+template<typename Op>
+static double benchOp (Op a_Op, size_t a_Calls, size_t a_Runs) {
+
+    double best = 0.0;
+
+    for (size_t i=0; i<a_Runs; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t j=0; j<a_Calls; ++j) {
+            a_Op();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        double time = std::chrono::duration<double>(t1 - t0).count();
+        best = (i == 0) ? time : std::min(best, time);
+    }
+
+    return best / double(a_Calls);
+}
+
+// ============================================================================
+
+int runBigFloatBenchmark (std::shared_ptr<spdlog::logger> a_Logger) {
+
+    const size_t RUNS = 3;
+
+    a_Logger->info("BigFloat benchmark, {}-bit limbs, best of {} runs",
+        BigFloat::LIMB_BITS, RUNS);
+
+    // Operations. The values stay bounded so the exponents do not run away.
+    for (size_t bits : s_Precisions) {
+
+        BigFloat a = makeNumber( 0.7, bits);
+        BigFloat b = makeNumber(-0.3, bits);
+        BigFloat r (0.0, bits);
+
+        size_t calls = std::max(size_t(1), size_t(200000000) / (bits * bits));
+
+        double add = benchOp([&] { BigFloat::add(r, a, b); }, calls * 16, RUNS);
+        double mul = benchOp([&] { BigFloat::mul(r, a, b); }, calls, RUNS);
+        double sqr = benchOp([&] { BigFloat::sqr(r, a);    }, calls, RUNS);
+
+        a_Logger->info("  {:5} bits: add {:9.1f} ns, mul {:9.1f} ns, sqr {:9.1f} ns",
+            r.getBits(), add * 1e9, mul * 1e9, sqr * 1e9);
+    }
+
+    // A reference orbit at a 1e-1000 zoom, of an interior point so that it
+    // runs for all the iterations
+    const size_t MAX_ITER = 1000000;
+    const double ZOOM     = 1000.0 * log2(10.0);
+    const size_t bits     = size_t(ceil(ZOOM)) + 64;
+
+    std::array<BigFloat, 2> center = {
+        makeNumber(-0.1, bits),
+        makeNumber( 0.1, bits)
+    };
+
+    ReferenceOrbit orbit;
+
+    auto t0 = std::chrono::steady_clock::now();
+    orbit.compute(FractalType::Mandelbrot, center, {0.0, 0.0}, MAX_ITER);
+    auto t1 = std::chrono::steady_clock::now();
+
+    double time = std::chrono::duration<double>(t1 - t0).count();
+
+    a_Logger->info("Reference orbit, zoom 1e-1000, {} bits, {} iter: {:8.3f} s, {:6.1f} ns/iter",
+        center[0].getBits(), orbit.getLength(), time, time / double(orbit.getLength()) * 1e9);
+
+    return 0;
+}
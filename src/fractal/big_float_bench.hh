@@ -0,0 +1,15 @@
+#ifndef FRACTAL_BIG_FLOAT_BENCH_HH
+#define FRACTAL_BIG_FLOAT_BENCH_HH
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+// ============================================================================
+
+/// Benchmarks the arbitrary precision arithmetic. The basic operations are
+/// timed at precisions from double-double to beyond 1e-1000 zooms, then a
+/// reference orbit is computed at a 1e-1000 zoom.
+int runBigFloatBenchmark (std::shared_ptr<spdlog::logger> a_Logger);
+
+#endif // FRACTAL_BIG_FLOAT_BENCH_HH
@@ -0,0 +1,145 @@
+#include "bla_table.hh"
+
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+// ============================================================================
+
+/// Runs a function for index ranges split evenly among threads
+static void parallelFor (size_t a_Count, size_t a_Threads,
+                         const std::function<void(size_t, size_t)>& a_Func)
+{
+    size_t count = std::max<size_t>(1, std::min(a_Threads, a_Count / 1024));
+    if (count == 1) {
+        a_Func(0, a_Count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i=0; i<count; ++i) {
+        size_t beg = (a_Count *  i)      / count;
+        size_t end = (a_Count * (i + 1)) / count;
+        threads.push_back(std::thread(a_Func, beg, end));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// ============================================================================
+
+void BlaTable::build (const ReferenceOrbit& a_Orbit,
+                      double a_MaxOffset,
+                      size_t a_Threads)
+{
+    const auto& orbit = a_Orbit.getOrbit();
+    bool isJulia = (a_Orbit.getType() == FractalType::Julia);
+
+    m_Levels.clear();
+    m_MaxOffset = a_MaxOffset;
+
+    if (orbit.size() < 2) {
+        return;
+    }
+
+    if (a_Threads == 0) {
+        a_Threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Single iteration steps:
+    //   dz(m+1) = 2 * Z(m) * dz(m) + dz(m)^2 + dc
+    // The squared term is negligible while |dz| < EPSILON * |2 * Z(m)|
+    m_Levels.push_back(std::vector<Step>(orbit.size() - 1));
+    auto& first = m_Levels.back();
+
+    parallelFor(first.size(), a_Threads, [&](size_t a_Beg, size_t a_End) {
+        for (size_t m=a_Beg; m<a_End; ++m) {
+            Step& step  = first[m];
+            step.a      = 2.0 * orbit[m];
+            step.b      = isJulia ? 0.0 : 1.0;
+            step.radius = EPSILON * std::abs(step.a);
+        }
+    });
+
+    // Merge pairs of steps. For x followed by y:
+    //   A = Ay * Ax
+    //   B = Ay * Bx + By
+    //   R = min(Rx, (Ry - |Bx| * |dc|) / |Ax|)
+    while (m_Levels.back().size() >= 2) {
+        const auto& prev = m_Levels.back();
+        std::vector<Step> next (prev.size() / 2);
+
+        parallelFor(next.size(), a_Threads, [&](size_t a_Beg, size_t a_End) {
+            for (size_t i=a_Beg; i<a_End; ++i) {
+                const Step& x = prev[2*i + 0];
+                const Step& y = prev[2*i + 1];
+                Step& step = next[i];
+
+                double ax = std::abs(x.a);
+                double ry = (y.radius - std::abs(x.b) * a_MaxOffset);
+
+                step.a      = y.a * x.a;
+                step.b      = y.a * x.b + y.b;
+                step.radius = (ax > 0.0) ? std::min(x.radius, std::max(0.0, ry / ax)) : x.radius;
+            }
+        });
+
+        m_Levels.push_back(std::move(next));
+    }
+}
+
+void BlaTable::clear () {
+    m_Levels.clear();
+    m_MaxOffset = 0.0;
+}
+
+// ============================================================================
+
+double BlaTable::getMaxOffset () const {
+    return m_MaxOffset;
+}
+
+size_t BlaTable::getLevelCount () const {
+    return m_Levels.size();
+}
+
+const std::vector<BlaTable::Step>& BlaTable::getLevel (size_t a_Level) const {
+    return m_Levels.at(a_Level);
+}
+
+const BlaTable::Step* BlaTable::find (size_t a_Iter,
+                                      double a_Offset,
+                                      size_t a_MaxLength,
+                                      size_t* a_Length) const
+{
+    // Validity radii do not grow with the level so the first level that
+    // does not apply terminates the search.
+    const Step* found = nullptr;
+
+    for (size_t level=0; level<m_Levels.size(); ++level) {
+        size_t length = size_t(1) << level;
+        size_t index  = a_Iter >> level;
+
+        // Steps start at multiples of their length
+        if ((a_Iter & (length - 1)) != 0 || length > a_MaxLength) {
+            break;
+        }
+        if (index >= m_Levels[level].size()) {
+            break;
+        }
+
+        const Step& step = m_Levels[level][index];
+        if (!(a_Offset < step.radius)) {
+            break;
+        }
+
+        found = &step;
+        if (a_Length != nullptr) {
+            *a_Length = length;
+        }
+    }
+
+    return found;
+}
@@ -0,0 +1,78 @@
+#ifndef FRACTAL_BLA_TABLE_HH
+#define FRACTAL_BLA_TABLE_HH
+
+#include "reference_orbit.hh"
+
+#include <vector>
+#include <complex>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// A table of bivariate linear approximations (BLA) of a reference orbit.
+///
+/// While the offset of a pixel from the reference is small enough the
+/// squared term of the perturbed iteration can be neglected and a run of
+/// iterations starting at m collapses to:
+///
+///   dz(m+l) = A * dz(m) + B * dc
+///
+/// Level k of the table holds steps of 2^k iterations starting at
+/// multiples of 2^k, each merged from two steps of the level below.
+/// Unlike the series approximation the table does not depend on the view
+/// center, only on an upper bound of pixel offsets.
+class BlaTable
+{
+public:
+
+    /// Complex number type
+    typedef std::complex<double> Complex;
+
+    /// A single approximation step
+    struct Step {
+        /// Coefficient of the orbit offset
+        Complex a;
+        /// Coefficient of the pixel offset
+        Complex b;
+        /// Largest orbit offset for which the step is valid
+        double  radius;
+    };
+
+    /// Relative magnitude of the neglected squared term
+    static constexpr double EPSILON = 1.0 / (1 << 24);
+
+    /// Builds the table. a_MaxOffset is the largest pixel offset from the
+    /// reference point the table is going to be used for. The work is split
+    /// among a_Threads threads, zero means all available.
+    void build (const ReferenceOrbit& a_Orbit,
+                double a_MaxOffset,
+                size_t a_Threads = 0);
+
+    /// Clears the table
+    void clear ();
+
+    /// Returns the pixel offset bound the table was built for
+    double getMaxOffset () const;
+    /// Returns the number of levels
+    size_t getLevelCount () const;
+    /// Returns steps of a level
+    const std::vector<Step>& getLevel (size_t a_Level) const;
+
+    /// Finds the longest step that can be taken at iteration a_Iter for the
+    /// given orbit offset magnitude and which is not longer than
+    /// a_MaxLength. Returns nullptr if there is none.
+    const Step* find (size_t a_Iter,
+                      double a_Offset,
+                      size_t a_MaxLength,
+                      size_t* a_Length) const;
+
+protected:
+
+    /// Pixel offset bound
+    double m_MaxOffset = 0.0;
+    /// Levels
+    std::vector<std::vector<Step>> m_Levels;
+};
+
+#endif // FRACTAL_BLA_TABLE_HH
@@ -0,0 +1,277 @@
+#include "cpu_bench.hh"
+#include "cpu_renderer.hh"
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+/// A benchmark view
+struct BenchView {
+    const char*  name;
+    FractalType  type;
+    double       position[2];
+    double       zoom;
+    double       coeff[2];
+    size_t       maxIter;
+};
+
+/// Views with a lot of boundary pixels, where the iteration counts of
+/// neighbouring pixels differ the most
+static const BenchView s_Views[] = {
+    {"seahorse valley", FractalType::Mandelbrot, {-0.743643887, 0.131825904}, 10.0, {0.0, 0.0}, 1024},
+    {"elephant valley", FractalType::Mandelbrot, { 0.2925,      0.0149     },  8.0, {0.0, 0.0}, 1024},
+    {"dendrite julia",  FractalType::Julia,      { 0.0,         0.0        },  0.0, {0.0, 1.0},  512},
+};
+
+/// A view with a lot of interior pixels for the interior checks
+static const BenchView s_InteriorView =
+    {"whole set", FractalType::Mandelbrot, {-0.5, 0.0}, -1.0, {0.0, 0.0}, 4096};
+
+/// A point on the boundary to zoom in too deep for doubles, each coordinate
+/// is a sum of three doubles
+static const double s_DeepPoint[2][3] = {
+    {-0.746834443945422,  2.1513288174329907e-17, 4.13874627869309e-34},
+    { 0.06565369262480573, -4.116826611020766e-18, -2.728118153240369e-34},
+};
+
+/// Zoom levels of the fixed-point kernel benchmark
+static const double s_DeepZooms[] = {60.0, 90.0};
+
+/// Interior check combinations
+static const struct {
+    const char* name;
+    unsigned    checks;
+} s_InteriorChecks[] = {
+    {"none",        0},
+    {"bulbs",       INTERIOR_BULBS},
+    {"periodicity", INTERIOR_PERIODICITY},
+    {"derivative",  INTERIOR_DERIVATIVE},
+    {"all",         INTERIOR_ALL},
+};
+
+// ============================================================================
+
+/// Renders a view and returns the best time of several runs. The kernel is
+/// either a precision flag or a kernel function, see CpuRenderer::render().
+template <typename Kernel>
+static double benchView (CpuRenderer& a_Renderer, const CpuKernelArgs& a_Args,
+                         Kernel a_Kernel, size_t a_Runs,
+                         float* a_Field, CpuKernelStats* a_Stats)
+{
+    double best = 0.0;
+
+    for (size_t i=0; i<a_Runs; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        a_Renderer.render(a_Args, a_Kernel, a_Field, a_Stats);
+        auto t1 = std::chrono::steady_clock::now();
+
+        double time = std::chrono::duration<double>(t1 - t0).count();
+        best = (i == 0) ? time : std::min(best, time);
+    }
+
+    return best;
+}
+
+/// Returns the name of a refill mode
+static const char* getRefillName (CpuRefill a_Refill) {
+    switch (a_Refill) {
+    case CpuRefill::Off:  return "plain";
+    case CpuRefill::On:   return "refill";
+    case CpuRefill::Auto: return "auto";
+    }
+
+    return "unknown";
+}
+
+/// Makes kernel arguments for a view
+static CpuKernelArgs makeArgs (const BenchView& a_View, size_t a_Width, size_t a_Height) {
+
+    CpuKernelArgs args;
+    args.type        = a_View.type;
+    args.position[0] = a_View.position[0];
+    args.position[1] = a_View.position[1];
+    args.scale       = pow(2.0, a_View.zoom);
+    args.coeff[0]    = a_View.coeff[0];
+    args.coeff[1]    = a_View.coeff[1];
+    args.maxIter     = a_View.maxIter;
+    args.width       = a_Width;
+    args.height      = a_Height;
+
+    return args;
+}
+
+// ============================================================================
+
+int runCpuBenchmark (std::shared_ptr<spdlog::logger> a_Logger) {
+
+    const size_t WIDTH  = 1280;
+    const size_t HEIGHT = 720;
+    const size_t RUNS   = 3;
+
+    CpuRenderer renderer;
+    std::vector<float> field (WIDTH * HEIGHT);
+
+    // Instruction sets supported by the CPU
+    std::vector<CpuIsa> isas = {CpuIsa::Generic};
+#if defined(__x86_64__)
+    CpuIsa detected = detectCpuIsa();
+    for (CpuIsa isa : {CpuIsa::SSE2, CpuIsa::AVX2, CpuIsa::AVX512}) {
+        if (int(isa) <= int(detected)) {
+            isas.push_back(isa);
+        }
+    }
+#endif
+
+    a_Logger->info("CPU benchmark, {}x{}, {} threads, best of {} runs",
+        WIDTH, HEIGHT, renderer.getThreadCount(), RUNS);
+
+    for (const auto& view : s_Views) {
+
+        CpuKernelArgs args = makeArgs(view, WIDTH, HEIGHT);
+
+        a_Logger->info("{}, {} iter", view.name, view.maxIter);
+
+        for (CpuIsa isa : isas) {
+            for (bool isDouble : {false, true}) {
+                for (CpuRefill refill : {CpuRefill::Off, CpuRefill::On, CpuRefill::Auto}) {
+
+                    renderer.setIsa(isa);
+                    renderer.setRefill(refill);
+
+                    CpuKernelStats stats;
+                    double best = benchView(renderer, args, isDouble, RUNS,
+                                            field.data(), &stats);
+
+                    a_Logger->info("  {:8} {:6} {:6}: {:8.2f} Mpix/s, lanes {:5.1f}%",
+                        getCpuIsaName(isa),
+                        isDouble ? "double" : "float",
+                        getRefillName(refill),
+                        double(stats.pixels) / best * 1e-6,
+                        stats.getUtilization() * 100.0
+                        );
+                }
+            }
+        }
+    }
+
+    // Interior checks, with the best instruction set
+    const BenchView& view = s_InteriorView;
+    CpuKernelArgs args = makeArgs(view, WIDTH, HEIGHT);
+    args.epsilon = 1.0e-3 * 2.0 / (double(WIDTH) * args.scale);
+
+    renderer.setIsa(isas.back());
+    renderer.setRefill(CpuRefill::On);
+
+    a_Logger->info("{}, {} iter, interior checks, {}",
+        view.name, view.maxIter, getCpuIsaName(isas.back()));
+
+    for (bool isDouble : {false, true}) {
+        double none = 0.0;
+
+        for (const auto& check : s_InteriorChecks) {
+            args.interior = check.checks;
+
+            double best = benchView(renderer, args, isDouble, RUNS,
+                                    field.data(), nullptr);
+            if (check.checks == 0) {
+                none = best;
+            }
+
+            a_Logger->info("  {:6} {:11}: {:8.2f} ms, speedup {:5.2f}x",
+                isDouble ? "double" : "float",
+                check.name,
+                best * 1e3,
+                none / best
+                );
+        }
+    }
+
+    // Subdivision, without interior checks
+    args.interior = 0;
+
+    a_Logger->info("{}, {} iter, subdivision, {}",
+        view.name, view.maxIter, getCpuIsaName(isas.back()));
+
+    for (bool isDouble : {false, true}) {
+        CpuKernelStats plain;
+        double none = 0.0;
+
+        for (bool subdivide : {false, true}) {
+            renderer.setSubdivide(subdivide);
+
+            CpuKernelStats stats;
+            double best = benchView(renderer, args, isDouble, RUNS,
+                                    field.data(), &stats);
+            if (!subdivide) {
+                plain = stats;
+                none  = best;
+            }
+
+            a_Logger->info("  {:6} {:11}: {:8.2f} ms, speedup {:5.2f}x, {:5.1f}% filled, {:5.2f}x fewer iterations",
+                isDouble ? "double" : "float",
+                subdivide ? "subdivide" : "plain",
+                best * 1e3,
+                none / best,
+                double(stats.filled) / double(stats.pixels + stats.filled) * 100.0,
+                double(plain.laneIters) / double(stats.laneIters)
+                );
+        }
+    }
+
+    renderer.setSubdivide(false);
+
+    // The fixed-point kernel is scalar and a lot slower, a smaller frame
+    // does. Doubles on a shallow view for comparison.
+    const size_t SMALL_WIDTH  = WIDTH  / 4;
+    const size_t SMALL_HEIGHT = HEIGHT / 4;
+
+    a_Logger->info("fixed128, {}x{}, {} iter", SMALL_WIDTH, SMALL_HEIGHT, s_Views[0].maxIter);
+
+    {
+        CpuKernelArgs args = makeArgs(s_Views[0], SMALL_WIDTH, SMALL_HEIGHT);
+        args.center[0] = Fixed128(args.position[0]);
+        args.center[1] = Fixed128(args.position[1]);
+
+        for (bool isFixed : {false, true}) {
+            CpuKernelStats stats;
+            double best = isFixed ?
+                benchView(renderer, args, cpuKernelFixed128, RUNS, field.data(), &stats) :
+                benchView(renderer, args, true, RUNS, field.data(), &stats);
+
+            a_Logger->info("  {:8} {:9} zoom {:3.0f}: {:8.2f} ms, {:6.2f} ns/iter",
+                isFixed ? "fixed128" : getCpuIsaName(isas.back()),
+                isFixed ? "" : "double",
+                s_Views[0].zoom,
+                best * 1e3,
+                best / double(stats.laneIters) * renderer.getThreadCount() * 1e9
+                );
+        }
+    }
+
+    for (double zoom : s_DeepZooms) {
+        BenchView view = s_Views[0];
+        view.zoom = zoom;
+
+        CpuKernelArgs args = makeArgs(view, SMALL_WIDTH, SMALL_HEIGHT);
+        for (size_t i=0; i<2; ++i) {
+            args.center[i] = Fixed128(s_DeepPoint[i][0]) +
+                             Fixed128(s_DeepPoint[i][1]) +
+                             Fixed128(s_DeepPoint[i][2]);
+        }
+
+        CpuKernelStats stats;
+        double best = benchView(renderer, args, cpuKernelFixed128, RUNS,
+                                field.data(), &stats);
+
+        a_Logger->info("  {:8} {:9} zoom {:3.0f}: {:8.2f} ms, {:6.2f} ns/iter",
+            "fixed128", "", zoom,
+            best * 1e3,
+            best / double(stats.laneIters) * renderer.getThreadCount() * 1e9
+            );
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef FRACTAL_CPU_BENCH_HH
+#define FRACTAL_CPU_BENCH_HH
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+// ============================================================================
+
+/// Benchmarks the CPU kernels on views with a lot of boundary pixels. Every
+/// supported instruction set and precision is run with and without lane
+/// refill and the throughput and lane utilization are reported.
+int runCpuBenchmark (std::shared_ptr<spdlog::logger> a_Logger);
+
+#endif // FRACTAL_CPU_BENCH_HH
@@ -0,0 +1,98 @@
+#include "cpu_kernel_impl.hh"
+
+// ============================================================================
+
+/// Scalar wrapper for architectures without a dedicated kernel
+template <typename T>
+struct Generic {
+    typedef T    Real;
+    typedef T    Vec;
+    typedef bool Mask;
+
+    static constexpr size_t Width = 1;
+
+    static inline Vec  set1   (Real a)              { return a; }
+    static inline Vec  load   (const Real* p)       { return *p; }
+    static inline void store  (Real* p, Vec a)      { *p = a; }
+    static inline Vec  add    (Vec a, Vec b)        { return a + b; }
+    static inline Vec  sub    (Vec a, Vec b)        { return a - b; }
+    static inline Vec  mul    (Vec a, Vec b)        { return a * b; }
+    static inline Mask le     (Vec a, Vec b)        { return a <= b; }
+    static inline Mask lt     (Vec a, Vec b)        { return a < b; }
+    static inline Mask land   (Mask a, Mask b)      { return a && b; }
+    static inline Mask lor    (Mask a, Mask b)      { return a || b; }
+    static inline bool any    (Mask m)              { return m; }
+    static inline unsigned bits (Mask m)            { return m ? 1u : 0u; }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return m ? a : b; }
+    static inline Vec  inc    (Vec n, Mask m)       { return m ? n + T(1) : n; }
+};
+
+const CpuKernelSet& getCpuKernelsGeneric () {
+    return makeCpuKernelSet<Generic<float>, Generic<double>>();
+}
+
+// ============================================================================
+
+CpuKernelStats& CpuKernelStats::operator += (const CpuKernelStats& a_Other) {
+    pixels    += a_Other.pixels;
+    filled    += a_Other.filled;
+    laneIters += a_Other.laneIters;
+    laneSlots += a_Other.laneSlots;
+    return *this;
+}
+
+double CpuKernelStats::getUtilization () const {
+    return laneSlots ? double(laneIters) / double(laneSlots) : 0.0;
+}
+
+// ============================================================================
+
+CpuIsa detectCpuIsa () {
+
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return CpuIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return CpuIsa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return CpuIsa::SSE2;
+    }
+#endif
+
+    return CpuIsa::Generic;
+}
+
+const char* getCpuIsaName (CpuIsa a_Isa) {
+    switch (a_Isa) {
+    case CpuIsa::Generic: return "generic";
+    case CpuIsa::SSE2:    return "SSE2";
+    case CpuIsa::AVX2:    return "AVX2";
+    case CpuIsa::AVX512:  return "AVX-512";
+    }
+
+    return "unknown";
+}
+
+CpuKernel getCpuKernel (CpuIsa a_Isa, bool a_Double, bool a_Refill) {
+
+    const CpuKernelSet* kernels = nullptr;
+
+    switch (a_Isa) {
+#if defined(__x86_64__)
+    case CpuIsa::SSE2:   kernels = &getCpuKernelsSse2();   break;
+    case CpuIsa::AVX2:   kernels = &getCpuKernelsAvx2();   break;
+    case CpuIsa::AVX512: kernels = &getCpuKernelsAvx512(); break;
+#endif
+    default:             kernels = &getCpuKernelsGeneric(); break;
+    }
+
+    if (a_Refill) {
+        return a_Double ? kernels->doubleRefill : kernels->floatRefill;
+    }
+
+    return a_Double ? kernels->doublePlain : kernels->floatPlain;
+}
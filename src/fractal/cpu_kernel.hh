@@ -0,0 +1,158 @@
+#ifndef FRACTAL_CPU_KERNEL_HH
+#define FRACTAL_CPU_KERNEL_HH
+
+#include "fractal.hh"
+#include "fixed128.hh"
+#include "float_exp.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+
+class ReferenceOrbit;
+class BlaTable;
+
+/// Reference of the perturbation kernel, see cpuKernelPerturbation()
+struct CpuPerturbation {
+
+    /// Reference orbit
+    const ReferenceOrbit* orbit = nullptr;
+    /// BLA table of the orbit, no iterations are skipped without it
+    const BlaTable*       bla = nullptr;
+    /// Offset of the view center from the reference point
+    ComplexExp offset;
+    /// Inverse of the view scale
+    FloatExp   invScale;
+};
+
+/// Parameters of a CPU fractal kernel. They match the uniforms the fractal
+/// shaders get from AcidbrotApp::renderScene().
+struct CpuKernelArgs {
+
+    /// Fractal type
+    FractalType type = FractalType::Mandelbrot;
+
+    /// View center on the complex plane
+    double position[2] = {0.0, 0.0};
+    /// View center in fixed point, used by cpuKernelFixed128() only
+    Fixed128 center[2];
+    /// Reference, used by cpuKernelPerturbation() only
+    const CpuPerturbation* perturbation = nullptr;
+    /// View rotation (radians)
+    double rotation    = 0.0;
+    /// View scale (2^zoom)
+    double scale       = 1.0;
+    /// Julia set coefficient
+    double coeff[2]    = {0.0, 0.0};
+
+    /// Iteration limit
+    size_t maxIter = 256;
+
+    /// Interior checks, a mask of InteriorCheck flags
+    unsigned interior = 0;
+    /// Distance under which an orbit counts as periodic
+    double   epsilon  = 0.0;
+
+    /// Field size in pixels
+    size_t width   = 0;
+    size_t height  = 0;
+};
+
+/// Kernel statistics
+struct CpuKernelStats {
+
+    /// Pixel count
+    uint64_t pixels    = 0;
+    /// Pixels filled without iterating (see cpuSubdivide())
+    uint64_t filled    = 0;
+    /// Iterations done by all pixels
+    uint64_t laneIters = 0;
+    /// Lane slots spent, vector iterations times the vector width
+    uint64_t laneSlots = 0;
+
+    /// Accumulates stats. Not inline, the kernels calling it are compiled
+    /// for different instruction sets.
+    CpuKernelStats& operator += (const CpuKernelStats& a_Other);
+
+    /// Returns the fraction of lane slots doing useful work
+    double getUtilization () const;
+};
+
+/// A kernel computes the [a_X0, a_X1) x [a_Y0, a_Y1) rectangle of the
+/// smooth iteration count field. Rows go bottom-up as in OpenGL
+/// framebuffers. Interior pixels are those with the count equal to the
+/// iteration limit. Stats are accumulated if a_Stats is not null.
+typedef void (*CpuKernel)(const CpuKernelArgs& a_Args,
+                          size_t a_X0, size_t a_Y0,
+                          size_t a_X1, size_t a_Y1,
+                          float* a_Field,
+                          CpuKernelStats* a_Stats);
+
+/// Kernels for one instruction set
+struct CpuKernelSet {
+
+    /// Kernels iterating a vector of pixels until all of them finish
+    CpuKernel floatPlain;
+    CpuKernel doublePlain;
+
+    /// Kernels replacing finished pixels in a vector with new ones. The
+    /// plain ones for the scalar set.
+    CpuKernel floatRefill;
+    CpuKernel doubleRefill;
+};
+
+/// Instruction sets with kernel implementations
+enum class CpuIsa {
+    Generic,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/// Detects the best instruction set supported by the CPU
+CpuIsa detectCpuIsa ();
+
+/// Returns name of an instruction set
+const char* getCpuIsaName (CpuIsa a_Isa);
+
+/// Returns a kernel for the given instruction set, precision and variant
+CpuKernel getCpuKernel (CpuIsa a_Isa, bool a_Double, bool a_Refill = true);
+
+/// The Q4.124 fixed-point kernel for views too deep for doubles. Points are
+/// the fixed-point center plus pixel offsets computed in doubles. It is
+/// scalar, orbits leave fixed point for doubles once they escape for sure.
+/// The bulb check is done in doubles with a margin so points right at the
+/// bulb borders are iterated.
+void cpuKernelFixed128 (const CpuKernelArgs& a_Args,
+                        size_t a_X0, size_t a_Y0,
+                        size_t a_X1, size_t a_Y1,
+                        float* a_Field,
+                        CpuKernelStats* a_Stats);
+
+/// The perturbation kernel for views too deep for fixed point, the CPU
+/// counterpart of mandelbrot_perturb.fsh. Pixels iterate their offset from
+/// the reference orbit, in floatexp until it gets into the double range,
+/// and skip iterations with the BLA table the shader uses as well. The
+/// position and the view scale come from a_Args.perturbation. Mandelbrot
+/// set pixels get rebased, glitched Julia set pixels are marked with -0.5
+/// as in iter.fsh. There are no interior checks.
+void cpuKernelPerturbation (const CpuKernelArgs& a_Args,
+                            size_t a_X0, size_t a_Y0,
+                            size_t a_X1, size_t a_Y1,
+                            float* a_Field,
+                            CpuKernelStats* a_Stats);
+
+// ============================================================================
+
+/// Kernel sets. Each one is built in a separate translation unit with
+/// instruction set specific compiler flags.
+const CpuKernelSet& getCpuKernelsGeneric ();
+
+#if defined(__x86_64__)
+const CpuKernelSet& getCpuKernelsSse2    ();
+const CpuKernelSet& getCpuKernelsAvx2    ();
+const CpuKernelSet& getCpuKernelsAvx512  ();
+#endif
+
+#endif // FRACTAL_CPU_KERNEL_HH
@@ -0,0 +1,62 @@
+#include "cpu_kernel_impl.hh"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// ============================================================================
+
+/// AVX2 wrapper, 8x float
+struct Avx2Float {
+    typedef float  Real;
+    typedef __m256 Vec;
+    typedef __m256 Mask;
+
+    static constexpr size_t Width = 8;
+
+    static inline Vec  set1   (Real a)              { return _mm256_set1_ps(a); }
+    static inline Vec  load   (const Real* p)       { return _mm256_load_ps(p); }
+    static inline void store  (Real* p, Vec a)      { _mm256_store_ps(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm256_add_ps(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm256_sub_ps(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm256_mul_ps(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static inline Mask land   (Mask a, Mask b)      { return _mm256_and_ps(a, b); }
+    static inline Mask lor    (Mask a, Mask b)      { return _mm256_or_ps(a, b); }
+    static inline bool any    (Mask m)              { return _mm256_movemask_ps(m) != 0; }
+    static inline unsigned bits (Mask m)            { return _mm256_movemask_ps(m); }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm256_blendv_ps(b, a, m); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm256_add_ps(n, _mm256_and_ps(m, _mm256_set1_ps(1.0f))); }
+};
+
+/// AVX2 wrapper, 4x double
+struct Avx2Double {
+    typedef double  Real;
+    typedef __m256d Vec;
+    typedef __m256d Mask;
+
+    static constexpr size_t Width = 4;
+
+    static inline Vec  set1   (Real a)              { return _mm256_set1_pd(a); }
+    static inline Vec  load   (const Real* p)       { return _mm256_load_pd(p); }
+    static inline void store  (Real* p, Vec a)      { _mm256_store_pd(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm256_add_pd(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm256_sub_pd(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm256_mul_pd(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static inline Mask land   (Mask a, Mask b)      { return _mm256_and_pd(a, b); }
+    static inline Mask lor    (Mask a, Mask b)      { return _mm256_or_pd(a, b); }
+    static inline bool any    (Mask m)              { return _mm256_movemask_pd(m) != 0; }
+    static inline unsigned bits (Mask m)            { return _mm256_movemask_pd(m); }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm256_blendv_pd(b, a, m); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm256_add_pd(n, _mm256_and_pd(m, _mm256_set1_pd(1.0))); }
+};
+
+// ============================================================================
+
+const CpuKernelSet& getCpuKernelsAvx2 () {
+    return makeCpuKernelSet<Avx2Float, Avx2Double>();
+}
+
+#endif // __AVX2__
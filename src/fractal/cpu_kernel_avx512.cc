@@ -0,0 +1,62 @@
+#include "cpu_kernel_impl.hh"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+// ============================================================================
+
+/// AVX-512 wrapper, 16x float
+struct Avx512Float {
+    typedef float     Real;
+    typedef __m512    Vec;
+    typedef __mmask16 Mask;
+
+    static constexpr size_t Width = 16;
+
+    static inline Vec  set1   (Real a)              { return _mm512_set1_ps(a); }
+    static inline Vec  load   (const Real* p)       { return _mm512_load_ps(p); }
+    static inline void store  (Real* p, Vec a)      { _mm512_store_ps(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm512_add_ps(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm512_sub_ps(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm512_mul_ps(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static inline Mask land   (Mask a, Mask b)      { return a & b; }
+    static inline Mask lor    (Mask a, Mask b)      { return a | b; }
+    static inline bool any    (Mask m)              { return m != 0; }
+    static inline unsigned bits (Mask m)            { return m; }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm512_mask_blend_ps(m, b, a); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm512_mask_add_ps(n, m, n, _mm512_set1_ps(1.0f)); }
+};
+
+/// AVX-512 wrapper, 8x double
+struct Avx512Double {
+    typedef double   Real;
+    typedef __m512d  Vec;
+    typedef __mmask8 Mask;
+
+    static constexpr size_t Width = 8;
+
+    static inline Vec  set1   (Real a)              { return _mm512_set1_pd(a); }
+    static inline Vec  load   (const Real* p)       { return _mm512_load_pd(p); }
+    static inline void store  (Real* p, Vec a)      { _mm512_store_pd(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm512_add_pd(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm512_sub_pd(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm512_mul_pd(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static inline Mask land   (Mask a, Mask b)      { return a & b; }
+    static inline Mask lor    (Mask a, Mask b)      { return a | b; }
+    static inline bool any    (Mask m)              { return m != 0; }
+    static inline unsigned bits (Mask m)            { return m; }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm512_mask_blend_pd(m, b, a); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm512_mask_add_pd(n, m, n, _mm512_set1_pd(1.0)); }
+};
+
+// ============================================================================
+
+const CpuKernelSet& getCpuKernelsAvx512 () {
+    return makeCpuKernelSet<Avx512Float, Avx512Double>();
+}
+
+#endif // __AVX512F__
@@ -0,0 +1,198 @@
+#include "cpu_kernel_impl.hh"
+#include "fixed128.hh"
+
+// ============================================================================
+
+/// Orbits are iterated in fixed point while their squared magnitude stays
+/// under this. Beyond it they escape for sure and z^2 + c could leave the
+/// fixed-point range.
+static constexpr double FIXED_RADIUS2 = 4.0;
+
+/// Larger Julia set coefficients and points would leave the fixed-point
+/// range, their orbits are iterated in doubles
+static constexpr double FIXED_MAX_COORD = 3.5;
+
+/// Squared derivative magnitude under which an orbit is attracted, the same
+/// as in CpuInteriorCheck
+static constexpr double DERIVATIVE_EPSILON = 1.0e-12;
+
+/// Points are only taken as lying in the main bulbs with this margin as the
+/// check is done in doubles. Points closer to the borders are iterated.
+static constexpr double BULB_MARGIN = 1.0e-12;
+
+/// Returns true if a point lies in the main cardioid or the period-2 bulb
+/// of the Mandelbrot set even with the double rounding of its coordinates
+static inline bool isSurelyInMainBulbs (double a_Re, double a_Im) {
+
+    double x  = a_Re - 0.25;
+    double y2 = a_Im * a_Im;
+    double q  = x * x + y2;
+
+    if (q * (q + x) + BULB_MARGIN <= 0.25 * y2) {
+        return true;
+    }
+
+    x = a_Re + 1.0;
+    return (x * x + y2) + BULB_MARGIN <= 0.0625;
+}
+
+/// Iterates an orbit and returns its smooth iteration count. The iteration
+/// and the interior checks follow cpuKernel().
+static float iterate (const CpuKernelArgs& a_Args,
+                      Fixed128 a_Zr, Fixed128 a_Zi,
+                      const Fixed128& a_Cr, const Fixed128& a_Ci,
+                      CpuKernelStats* a_Stats)
+{
+    const size_t maxIter     = a_Args.maxIter;
+    const bool   periodicity = (a_Args.interior & INTERIOR_PERIODICITY) != 0;
+    const bool   derivative  = (a_Args.interior & INTERIOR_DERIVATIVE)  != 0;
+    const double eps2        = a_Args.epsilon * a_Args.epsilon;
+
+    // Orbit points closer than this in coarse values get compared exactly
+    const double near = a_Args.epsilon + 2.0 * Fixed128::HI_UNIT;
+
+    const double cx = double(a_Cr);
+    const double cy = double(a_Ci);
+
+    Fixed128 zr = a_Zr;
+    Fixed128 zi = a_Zi;
+    double   x  = double(zr);
+    double   y  = double(zi);
+    size_t   n  = 0;
+
+    // Interior check state
+    Fixed128 sr = zr;
+    Fixed128 si = zi;
+    double   dx = 1.0;
+    double   dy = 0.0;
+    size_t   check = 1;
+
+    bool fits = fabs(cx) < FIXED_MAX_COORD && fabs(cy) < FIXED_MAX_COORD;
+
+    // Fixed point. The escape and the derivative check use coarse doubles,
+    // they do not need the precision.
+    while (fits && n < maxIter && x * x + y * y <= FIXED_RADIUS2) {
+
+        Fixed128 xy  = zr * zi;
+        Fixed128 zr1 = sqr(zr) - sqr(zi) + a_Cr;
+        Fixed128 zi1 = twice(xy) + a_Ci;
+        n++;
+
+        bool inside = false;
+
+        if (periodicity) {
+            Fixed128 er = zr1 - sr;
+            Fixed128 ei = zi1 - si;
+
+            if (fabs(er.getCoarse()) < near && fabs(ei.getCoarse()) < near) {
+                double ex = double(er);
+                double ey = double(ei);
+                inside = (ex * ex + ey * ey) < eps2;
+            }
+        }
+
+        bool save = (check <= n);
+
+        if (derivative) {
+            double ex = dx * x - dy * y;
+            double ey = dx * y + dy * x;
+            dx = ex + ex;
+            dy = ey + ey;
+
+            inside = inside || (check > 1 && (dx * dx + dy * dy) < DERIVATIVE_EPSILON);
+
+            if (save) {
+                dx = 1.0;
+                dy = 0.0;
+            }
+        }
+
+        if (save) {
+            sr = zr1;
+            si = zi1;
+            check *= 2;
+        }
+
+        zr = zr1;
+        zi = zi1;
+        x  = zr.getCoarse();
+        y  = zi.getCoarse();
+
+        if (inside) {
+            n = maxIter;
+        }
+    }
+
+    // The orbit escapes. Finish it in doubles up to the escape radius of
+    // the shaders which the smoothing depends on.
+    while (n < maxIter) {
+        double xx = x * x;
+        double yy = y * y;
+
+        if (xx + yy > 100.0) {
+            break;
+        }
+
+        double xy = x * y;
+        x = xx - yy + cx;
+        y = xy + xy + cy;
+        n++;
+    }
+
+    a_Stats->laneIters += n;
+    a_Stats->laneSlots += n;
+
+    return smoothIter(float(n), float(x), float(y), maxIter);
+}
+
+// ============================================================================
+
+void cpuKernelFixed128 (const CpuKernelArgs& a_Args,
+                        size_t a_X0, size_t a_Y0,
+                        size_t a_X1, size_t a_Y1,
+                        float* a_Field,
+                        CpuKernelStats* a_Stats)
+{
+    // Pixel offsets from the center are small, doubles hold them with the
+    // precision they need
+    CpuKernelArgs offsetArgs = a_Args;
+    offsetArgs.position[0] = 0.0;
+    offsetArgs.position[1] = 0.0;
+
+    const CpuKernelMapping<double> mapping (offsetArgs);
+    const bool isJulia = (a_Args.type == FractalType::Julia);
+    const bool bulbs   = !isJulia && (a_Args.interior & INTERIOR_BULBS);
+
+    const Fixed128 coeff[2] = {
+        Fixed128(mapping.coeff[0]),
+        Fixed128(mapping.coeff[1])
+    };
+
+    CpuKernelStats stats;
+
+    for (size_t y=a_Y0; y<a_Y1; ++y) {
+        float* out = a_Field + y * a_Args.width;
+
+        for (size_t x=a_X0; x<a_X1; ++x) {
+            double u, v;
+            mapping.get(x, y, &u, &v);
+
+            Fixed128 pr = a_Args.center[0] + Fixed128(u);
+            Fixed128 pi = a_Args.center[1] + Fixed128(v);
+
+            stats.pixels += 1;
+
+            if (bulbs && isSurelyInMainBulbs(double(pr), double(pi))) {
+                out[x] = float(a_Args.maxIter);
+                continue;
+            }
+
+            out[x] = isJulia ? iterate(a_Args, pr, pi, coeff[0], coeff[1], &stats) :
+                               iterate(a_Args, Fixed128(), Fixed128(), pr, pi, &stats);
+        }
+    }
+
+    if (a_Stats != nullptr) {
+        *a_Stats += stats;
+    }
+}
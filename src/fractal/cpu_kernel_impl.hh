@@ -0,0 +1,613 @@
+#ifndef FRACTAL_CPU_KERNEL_IMPL_HH
+#define FRACTAL_CPU_KERNEL_IMPL_HH
+
+#include "cpu_kernel.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// Everything below is compiled with the instruction set flags of the
+// including file. The anonymous namespace keeps each copy to its own file,
+// the linker would otherwise keep one of the inline and template instances
+// for all of them whatever instructions it has. For the same reason no
+// standard templates are instantiated for the real types here.
+namespace {
+
+// ============================================================================
+
+/// Smooths the iteration count the same way as mandelbrot.fsh does
+static inline float smoothIter (float a_Iter, float a_Zr, float a_Zi, size_t a_MaxIter) {
+
+    // Iteration limit reached
+    if (a_Iter >= float(a_MaxIter)) {
+        return a_Iter;
+    }
+
+    float n = a_Iter;
+    n -= logf(logf(sqrtf(a_Zr*a_Zr + a_Zi*a_Zi)) / logf(10.0f)) / logf(2.0f);
+
+    // Clamp, the same as std::min(std::max(n, 0), maxIter)
+    n = (n < 0.0f) ? 0.0f : n;
+    return (float(a_MaxIter) < n) ? float(a_MaxIter) : n;
+}
+
+/// Points of a field on the complex plane. Computed the same way as in the
+/// shader from uniforms as it gets them.
+template <typename Real>
+class CpuKernelMapping
+{
+public:
+
+    CpuKernelMapping (const CpuKernelArgs& a_Args) :
+        m_Args (a_Args)
+    {
+        // Rotation and Julia set coefficient are floats in the shader
+        const float rotation = float(a_Args.rotation);
+
+        m_Cos    = Real(cosf(rotation));
+        m_Sin    = Real(sinf(rotation));
+        m_Scale  = Real(a_Args.scale);
+        m_Pos[0] = Real(a_Args.position[0]);
+        m_Pos[1] = Real(a_Args.position[1]);
+        m_Aspect = float(a_Args.width) / float(a_Args.height);
+
+        coeff[0] = Real(float(a_Args.coeff[0]));
+        coeff[1] = Real(float(a_Args.coeff[1]));
+    }
+
+    /// Returns the point of a pixel center
+    inline void get (size_t a_X, size_t a_Y, Real* a_Re, Real* a_Im) const {
+
+        // Interpolated texture coordinates
+        const float u = -1.0f + 2.0f * (float(a_X) + 0.5f) / float(m_Args.width);
+        const float v = (-1.0f + 2.0f * (float(a_Y) + 0.5f) / float(m_Args.height)) / m_Aspect;
+
+        *a_Re = (m_Cos * Real(u) - m_Sin * Real(v)) / m_Scale + m_Pos[0];
+        *a_Im = (m_Sin * Real(u) + m_Cos * Real(v)) / m_Scale + m_Pos[1];
+    }
+
+    /// Julia set coefficient
+    Real coeff[2];
+
+protected:
+
+    const CpuKernelArgs& m_Args;
+
+    Real  m_Cos;
+    Real  m_Sin;
+    Real  m_Scale;
+    Real  m_Pos[2];
+    float m_Aspect;
+};
+
+/// An array of reals, in place of a standard container
+template <typename Real>
+class CpuKernelArray
+{
+public:
+
+    explicit CpuKernelArray (size_t a_Size) : m_Data (new Real[a_Size]) {}
+    ~CpuKernelArray () { delete[] m_Data; }
+
+    CpuKernelArray (const CpuKernelArray&) = delete;
+    CpuKernelArray& operator = (const CpuKernelArray&) = delete;
+
+    inline Real& operator [] (size_t i) { return m_Data[i]; }
+
+protected:
+
+    Real* m_Data;
+};
+
+/// Returns true if a point lies in the main cardioid or the period-2 bulb
+/// of the Mandelbrot set
+template <typename Real>
+static inline bool isInMainBulbs (Real a_Re, Real a_Im) {
+
+    Real x  = a_Re - Real(0.25);
+    Real y2 = a_Im * a_Im;
+    Real q  = x * x + y2;
+
+    if (q * (q + x) <= Real(0.25) * y2) {
+        return true;
+    }
+
+    x = a_Re + Real(1.0);
+    return (x * x + y2) <= Real(0.0625);
+}
+
+/// Periodicity and derivative interior checks of a vector of orbits. Orbit
+/// points are saved at iterations 1, 2, 4, 8... (Brent). An orbit that
+/// returns close to the last saved point is periodic. An orbit whose
+/// derivative shrinks to nearly zero since the last saved point is attracted
+/// by a periodic cycle. Either way the pixel lies inside.
+template <class V>
+class CpuInteriorCheck
+{
+public:
+
+    typedef typename V::Real Real;
+    typedef typename V::Vec  Vec;
+    typedef typename V::Mask Mask;
+
+    /// Squared derivative magnitude under which an orbit is attracted
+    static constexpr double DERIVATIVE_EPSILON = 1.0e-12;
+
+    CpuInteriorCheck (const CpuKernelArgs& a_Args) :
+        m_Periodicity (a_Args.interior & INTERIOR_PERIODICITY),
+        m_Derivative  (a_Args.interior & INTERIOR_DERIVATIVE),
+        m_Eps2        (V::set1(Real(a_Args.epsilon * a_Args.epsilon))),
+        m_DerEps2     (V::set1(Real(DERIVATIVE_EPSILON))),
+        m_One         (V::set1(Real(1.0))),
+        m_Sx          (V::set1(Real(0.0))),
+        m_Sy          (V::set1(Real(0.0))),
+        m_Dx          (m_One),
+        m_Dy          (V::set1(Real(0.0))),
+        m_Check       (m_One)
+    {
+        // Empty, the lanes get reset for their orbits
+    }
+
+    /// Returns true if any check is enabled
+    inline bool isEnabled () const {
+        return m_Periodicity || m_Derivative;
+    }
+
+    /// Resets all lanes for orbits starting at z
+    inline void reset (Vec a_Zx, Vec a_Zy) {
+        m_Sx    = a_Zx;
+        m_Sy    = a_Zy;
+        m_Dx    = m_One;
+        m_Dy    = V::set1(Real(0.0));
+        m_Check = m_One;
+    }
+
+    /// Resets a single lane, the state must be spilled
+    inline void resetLane (size_t a_Lane, Real a_Zx, Real a_Zy) {
+        m_Lanes[0][a_Lane] = a_Zx;
+        m_Lanes[1][a_Lane] = a_Zy;
+        m_Lanes[2][a_Lane] = Real(1.0);
+        m_Lanes[3][a_Lane] = Real(0.0);
+        m_Lanes[4][a_Lane] = Real(1.0);
+    }
+
+    /// Stores the state to per lane arrays
+    inline void spill () {
+        V::store(m_Lanes[0], m_Sx);
+        V::store(m_Lanes[1], m_Sy);
+        V::store(m_Lanes[2], m_Dx);
+        V::store(m_Lanes[3], m_Dy);
+        V::store(m_Lanes[4], m_Check);
+    }
+
+    /// Loads the state from per lane arrays
+    inline void fill () {
+        m_Sx    = V::load(m_Lanes[0]);
+        m_Sy    = V::load(m_Lanes[1]);
+        m_Dx    = V::load(m_Lanes[2]);
+        m_Dy    = V::load(m_Lanes[3]);
+        m_Check = V::load(m_Lanes[4]);
+    }
+
+    /// Checks orbits after an iteration from z to z' which brought the
+    /// iteration count to n. Returns active lanes found to be inside.
+    inline Mask update (Vec a_Zx, Vec a_Zy, Vec a_Zx1, Vec a_Zy1, Vec a_N, Mask a_Active) {
+
+        Vec  zero   = V::set1(Real(0.0));
+        Mask inside = V::lt(zero, zero);
+
+        // Periodicity
+        if (m_Periodicity) {
+            Vec dx = V::sub(a_Zx1, m_Sx);
+            Vec dy = V::sub(a_Zy1, m_Sy);
+            inside = V::lt(V::add(V::mul(dx, dx), V::mul(dy, dy)), m_Eps2);
+        }
+
+        Mask save = V::le(m_Check, a_N);
+
+        // Derivative of z' = z^2 + c with respect to z, accumulated since
+        // the last saved point. It is checked every iteration and frozen
+        // for finished lanes which keeps it from underflowing to denormals.
+        if (m_Derivative) {
+            Vec dx = V::sub(V::mul(m_Dx, a_Zx), V::mul(m_Dy, a_Zy));
+            Vec dy = V::add(V::mul(m_Dx, a_Zy), V::mul(m_Dy, a_Zx));
+            m_Dx = V::select(a_Active, V::add(dx, dx), m_Dx);
+            m_Dy = V::select(a_Active, V::add(dy, dy), m_Dy);
+
+            // The first segment starts at z=0 for the Mandelbrot set, its
+            // derivative is always zero so it is skipped.
+            Vec  d2    = V::add(V::mul(m_Dx, m_Dx), V::mul(m_Dy, m_Dy));
+            Mask small = V::land(V::lt(m_One, m_Check), V::lt(d2, m_DerEps2));
+            inside = V::lor(inside, small);
+
+            m_Dx = V::select(save, m_One, m_Dx);
+            m_Dy = V::select(save, zero,  m_Dy);
+        }
+
+        // Save points
+        m_Sx    = V::select(save, a_Zx1, m_Sx);
+        m_Sy    = V::select(save, a_Zy1, m_Sy);
+        m_Check = V::select(save, V::add(m_Check, m_Check), m_Check);
+
+        return V::land(inside, a_Active);
+    }
+
+protected:
+
+    bool m_Periodicity;
+    bool m_Derivative;
+
+    Vec  m_Eps2;
+    Vec  m_DerEps2;
+    Vec  m_One;
+
+    /// Saved orbit points
+    Vec  m_Sx;
+    Vec  m_Sy;
+    /// Derivatives
+    Vec  m_Dx;
+    Vec  m_Dy;
+    /// Iteration counts at which the next points get saved
+    Vec  m_Check;
+
+    /// Spilled state
+    alignas(64) Real m_Lanes[5][V::Width];
+};
+
+// ============================================================================
+
+/// The escape time kernel. V is a SIMD wrapper providing:
+///
+///  Real, Vec, Mask     - scalar, vector and lane mask types
+///  Width               - number of lanes
+///  set1, load, store   - broadcast, aligned load and store
+///  add, sub, mul       - arithmetic
+///  le, lt              - lane-wise a <= b, a < b
+///  land, lor, any      - mask and, or, test for any lane set
+///  bits                - mask as an integer, one bit per lane
+///  select              - lane-wise m ? a : b
+///  inc                 - adds one to lanes set in the mask
+///
+/// All arithmetic is done in the same order as in the shader so all
+/// instruction sets give identical results.
+///
+/// This variant iterates a vector of neighbouring pixels until the slowest
+/// of them finishes.
+template <class V>
+void cpuKernel (const CpuKernelArgs& a_Args,
+                size_t a_X0, size_t a_Y0,
+                size_t a_X1, size_t a_Y1,
+                float* a_Field,
+                CpuKernelStats* a_Stats)
+{
+    typedef typename V::Real Real;
+    typedef typename V::Vec  Vec;
+    typedef typename V::Mask Mask;
+
+    const size_t W = V::Width;
+
+    const CpuKernelMapping<Real> mapping (a_Args);
+    const bool isJulia = (a_Args.type == FractalType::Julia);
+
+    const Vec B2   = V::set1(Real(100.0));
+    const Vec zero = V::set1(Real(0.0));
+    const Vec maxN = V::set1(Real(a_Args.maxIter));
+
+    const bool bulbs = !isJulia && (a_Args.interior & INTERIOR_BULBS);
+    CpuInteriorCheck<V> check (a_Args);
+
+    alignas(64) Real px[W];
+    alignas(64) Real py[W];
+    alignas(64) Real zr[W];
+    alignas(64) Real zi[W];
+    alignas(64) Real it[W];
+
+    CpuKernelStats stats;
+
+    for (size_t y=a_Y0; y<a_Y1; ++y) {
+        for (size_t x0=a_X0; x0<a_X1; x0+=W) {
+
+            // Compute coordinates of points on the complex plane. Points in
+            // the main bulbs start finished.
+            for (size_t l=0; l<W; ++l) {
+                mapping.get(std::min(x0 + l, a_X1 - 1), y, &px[l], &py[l]);
+
+                bool inside = bulbs && isInMainBulbs(px[l], py[l]);
+                it[l] = inside ? Real(a_Args.maxIter) : Real(0.0);
+            }
+
+            // Initialize
+            Vec re = V::load(px);
+            Vec im = V::load(py);
+
+            Vec zx = isJulia ? re : zero;
+            Vec zy = isJulia ? im : zero;
+            Vec cx = isJulia ? V::set1(mapping.coeff[0]) : re;
+            Vec cy = isJulia ? V::set1(mapping.coeff[1]) : im;
+            Vec n  = V::load(it);
+
+            Mask active = V::lt(n, maxN);
+
+            if (check.isEnabled()) {
+                check.reset(zx, zy);
+            }
+
+            // Evaluate
+            for (size_t i=0; i<a_Args.maxIter; ++i) {
+                Vec xx = V::mul(zx, zx);
+                Vec yy = V::mul(zy, zy);
+
+                active = V::land(active, V::le(V::add(xx, yy), B2));
+                if (!V::any(active)) {
+                    break;
+                }
+
+                Vec xy = V::mul(zx, zy);
+                Vec zx1 = V::select(active, V::add(V::sub(xx, yy), cx), zx);
+                Vec zy1 = V::select(active, V::add(V::add(xy, xy), cy), zy);
+                n = V::inc(n, active);
+
+                stats.laneSlots += W;
+                stats.laneIters += __builtin_popcount(V::bits(active));
+
+                // Lanes found inside are finished
+                if (check.isEnabled()) {
+                    Mask inside = check.update(zx, zy, zx1, zy1, n, active);
+                    n      = V::select(inside, maxN, n);
+                    active = V::land(active, V::lt(n, maxN));
+                }
+
+                zx = zx1;
+                zy = zy1;
+            }
+
+            V::store(zr, zx);
+            V::store(zi, zy);
+            V::store(it, n);
+
+            // Smoothing
+            float* out = a_Field + y * a_Args.width + x0;
+            for (size_t l=0; l<W && x0 + l < a_X1; ++l) {
+                out[l] = smoothIter(float(it[l]), float(zr[l]), float(zi[l]), a_Args.maxIter);
+
+                stats.pixels += 1;
+            }
+        }
+    }
+
+    if (a_Stats != nullptr) {
+        *a_Stats += stats;
+    }
+}
+
+/// The escape time kernel with lane refill. Points of the whole rectangle
+/// are queued in structure-of-arrays layout. When lanes finish their
+/// results are written out and the lanes continue with the next queued
+/// points so that the lanes stay busy until the queue runs dry. Results
+/// are identical to the plain kernel.
+template <class V>
+void cpuKernelRefill (const CpuKernelArgs& a_Args,
+                      size_t a_X0, size_t a_Y0,
+                      size_t a_X1, size_t a_Y1,
+                      float* a_Field,
+                      CpuKernelStats* a_Stats)
+{
+    typedef typename V::Real Real;
+    typedef typename V::Vec  Vec;
+    typedef typename V::Mask Mask;
+
+    const size_t W    = V::Width;
+    const size_t NONE = size_t(-1);
+
+    const CpuKernelMapping<Real> mapping (a_Args);
+    const bool isJulia = (a_Args.type == FractalType::Julia);
+
+    // Queue points of the rectangle
+    const size_t width = a_X1 - a_X0;
+    const size_t count = width * (a_Y1 - a_Y0);
+
+    CpuKernelArray<Real> queueRe (count);
+    CpuKernelArray<Real> queueIm (count);
+
+    for (size_t i=0; i<count; ++i) {
+        mapping.get(a_X0 + i % width, a_Y0 + i / width, &queueRe[i], &queueIm[i]);
+    }
+
+    // Lane state
+    alignas(64) Real zr[W];
+    alignas(64) Real zi[W];
+    alignas(64) Real cr[W];
+    alignas(64) Real ci[W];
+    alignas(64) Real it[W];
+
+    size_t pixel[W];
+    size_t next = 0;
+
+    const bool bulbs = !isJulia && (a_Args.interior & INTERIOR_BULBS);
+    CpuInteriorCheck<V> check (a_Args);
+
+    CpuKernelStats stats;
+
+    // Writes out a pixel
+    auto output = [&](size_t i, Real n, Real x, Real y) {
+        a_Field[(a_Y0 + i / width) * a_Args.width + a_X0 + i % width] =
+            smoothIter(float(n), float(x), float(y), a_Args.maxIter);
+
+        stats.pixels += 1;
+    };
+
+    // Finishes a lane and loads the next point to it if there is one
+    auto refill = [&](size_t l) {
+
+        if (pixel[l] != NONE) {
+            output(pixel[l], it[l], zr[l], zi[l]);
+        }
+
+        // Points in the main bulbs need no lane
+        while (bulbs && next < count && isInMainBulbs(queueRe[next], queueIm[next])) {
+            output(next, Real(a_Args.maxIter), Real(0.0), Real(0.0));
+            next++;
+        }
+
+        // Nothing left. The lane stays finished.
+        if (next >= count) {
+            pixel[l] = NONE;
+            zr[l] = ci[l] = Real(0.0);
+            zi[l] = cr[l] = Real(0.0);
+            it[l] = Real(a_Args.maxIter);
+
+            check.resetLane(l, zr[l], zi[l]);
+            return;
+        }
+
+        pixel[l] = next;
+        zr[l] = isJulia ? queueRe[next] : Real(0.0);
+        zi[l] = isJulia ? queueIm[next] : Real(0.0);
+        cr[l] = isJulia ? mapping.coeff[0] : queueRe[next];
+        ci[l] = isJulia ? mapping.coeff[1] : queueIm[next];
+        it[l] = Real(0.0);
+        next++;
+
+        check.resetLane(l, zr[l], zi[l]);
+    };
+
+    for (size_t l=0; l<W; ++l) {
+        pixel[l] = NONE;
+        refill(l);
+    }
+
+    check.fill();
+
+    const Vec B2   = V::set1(Real(100.0));
+    const Vec maxN = V::set1(Real(a_Args.maxIter));
+    const Vec one  = V::set1(Real(1.0));
+
+    const unsigned full = (1u << W) - 1;
+
+    Vec zx = V::load(zr);
+    Vec zy = V::load(zi);
+    Vec cx = V::load(cr);
+    Vec cy = V::load(ci);
+    Vec n  = V::load(it);
+
+    // Iterate while there are points in the queue. Refilling has a fixed
+    // cost so it is done once enough lanes have finished. Until then the
+    // finished lanes are masked out.
+    const size_t threshold = std::max<size_t>(W / 4, 1);
+
+    while (next < count) {
+        Vec xx = V::mul(zx, zx);
+        Vec yy = V::mul(zy, zy);
+
+        Mask     active   = V::land(V::le(V::add(xx, yy), B2), V::lt(n, maxN));
+        unsigned finished = ~V::bits(active) & full;
+
+        if (size_t(__builtin_popcount(finished)) >= threshold) {
+
+            // Refill finished lanes
+            V::store(zr, zx);
+            V::store(zi, zy);
+            V::store(cr, cx);
+            V::store(ci, cy);
+            V::store(it, n);
+            check.spill();
+
+            for (size_t l=0; l<W; ++l) {
+                if (finished & (1u << l)) {
+                    refill(l);
+                }
+            }
+
+            check.fill();
+
+            zx = V::load(zr);
+            zy = V::load(zi);
+            cx = V::load(cr);
+            cy = V::load(ci);
+            n  = V::load(it);
+            continue;
+        }
+
+        Vec xy = V::mul(zx, zy);
+        Vec zx1, zy1;
+
+        // All lanes active, no masking needed
+        if (finished == 0) {
+            zx1 = V::add(V::sub(xx, yy), cx);
+            zy1 = V::add(V::add(xy, xy), cy);
+            n   = V::add(n, one);
+        }
+        else {
+            zx1 = V::select(active, V::add(V::sub(xx, yy), cx), zx);
+            zy1 = V::select(active, V::add(V::add(xy, xy), cy), zy);
+            n   = V::inc(n, active);
+        }
+
+        stats.laneSlots += W;
+        stats.laneIters += W - __builtin_popcount(finished);
+
+        // Lanes found inside finish
+        if (check.isEnabled()) {
+            n = V::select(check.update(zx, zy, zx1, zy1, n, active), maxN, n);
+        }
+
+        zx = zx1;
+        zy = zy1;
+    }
+
+    // Drain the remaining lanes
+    while (1) {
+        Vec xx = V::mul(zx, zx);
+        Vec yy = V::mul(zy, zy);
+
+        Mask active = V::land(V::le(V::add(xx, yy), B2), V::lt(n, maxN));
+        if (!V::any(active)) {
+            break;
+        }
+
+        Vec xy = V::mul(zx, zy);
+        Vec zx1 = V::select(active, V::add(V::sub(xx, yy), cx), zx);
+        Vec zy1 = V::select(active, V::add(V::add(xy, xy), cy), zy);
+        n = V::inc(n, active);
+
+        stats.laneSlots += W;
+        stats.laneIters += __builtin_popcount(V::bits(active));
+
+        if (check.isEnabled()) {
+            n = V::select(check.update(zx, zy, zx1, zy1, n, active), maxN, n);
+        }
+
+        zx = zx1;
+        zy = zy1;
+    }
+
+    V::store(zr, zx);
+    V::store(zi, zy);
+    V::store(it, n);
+
+    for (size_t l=0; l<W; ++l) {
+        refill(l);
+    }
+
+    if (a_Stats != nullptr) {
+        *a_Stats += stats;
+    }
+}
+
+/// Makes a kernel set from SIMD wrappers
+template <class VF, class VD>
+const CpuKernelSet& makeCpuKernelSet () {
+    // A single lane never idles, scalar sets only have the plain kernels
+    static const CpuKernelSet kernels = {
+        cpuKernel<VF>,
+        cpuKernel<VD>,
+        (VF::Width > 1) ? cpuKernelRefill<VF> : cpuKernel<VF>,
+        (VD::Width > 1) ? cpuKernelRefill<VD> : cpuKernel<VD>
+    };
+
+    return kernels;
+}
+
+} // namespace
+
+#endif // FRACTAL_CPU_KERNEL_IMPL_HH
@@ -0,0 +1,187 @@
+#include "cpu_kernel_impl.hh"
+#include "reference_orbit.hh"
+#include "bla_table.hh"
+
+// ============================================================================
+
+/// Escape radius squared, the same as in the shaders
+static constexpr double ESCAPE_RADIUS2 = ReferenceOrbit::ESCAPE_RADIUS2;
+
+/// Glitch tolerance of Julia set pixels (Pauldelbrot's criterion), the same
+/// as in mandelbrot_perturb.fsh
+static constexpr double GLITCH_TOLERANCE2 = 1.0e-6;
+
+/// Offsets are iterated in floatexp while their exponent is below this.
+/// Above it doubles hold them with full precision and their squares do not
+/// underflow to subnormals.
+static constexpr int64_t DOUBLE_EXPONENT = -960;
+
+/// Field value of glitched pixels (see iter.fsh)
+static constexpr float GLITCH_VALUE = -0.5f;
+
+typedef ReferenceOrbit::Complex Complex;
+
+/// Iterates the offset of a pixel orbit from the reference and returns its
+/// smooth iteration count. The iteration follows mandelbrot_perturb.fsh.
+static float iterate (const CpuKernelArgs& a_Args,
+                      ComplexExp a_Dz, const ComplexExp& a_Dc,
+                      CpuKernelStats* a_Stats)
+{
+    const CpuPerturbation& perturbation = *a_Args.perturbation;
+
+    const std::vector<Complex>& orbit = perturbation.orbit->getOrbit();
+    const BlaTable* bla     = perturbation.bla;
+    const size_t    length  = orbit.size();
+    const size_t    maxIter = a_Args.maxIter;
+    const bool      isJulia = (a_Args.type == FractalType::Julia);
+
+    ComplexExp dz = a_Dz;
+    size_t     m  = 0;
+    size_t     n  = 0;
+    size_t     steps = 0;
+
+    // Iterate in floatexp until the offset gets into the double range. The
+    // pixel orbit stays next to the reference meanwhile, it neither escapes
+    // before the reference does nor glitches.
+    auto isTiny = [](const ComplexExp& a) {
+        return a.getMantissa() == Complex(0.0, 0.0) || a.getExponent() < DOUBLE_EXPONENT;
+    };
+
+    while (isTiny(dz) && n < maxIter && m + 1 < length) {
+
+        size_t l = 0;
+        const BlaTable::Step* step = (bla != nullptr) ?
+            bla->find(m, double(abs(dz)), maxIter - n, &l) : nullptr;
+
+        if (step != nullptr) {
+            dz = step->a * dz + a_Dc * step->b;
+            m += l;
+            n += l;
+        }
+        else {
+            dz = dz * (2.0 * orbit[m]) + dz * dz + a_Dc;
+            m += 1;
+            n += 1;
+        }
+
+        steps++;
+
+        // Rebase when the reference gets closer to zero than the offset
+        if (!isJulia && std::abs(orbit[m]) < 2.0 * double(abs(dz))) {
+            ComplexExp z = ComplexExp(orbit[m]) + dz;
+            if (norm(z) < norm(dz)) {
+                dz = z;
+                m  = 0;
+            }
+        }
+    }
+
+    // To doubles
+    Complex dzd = Complex(dz);
+    Complex dcd = Complex(a_Dc);
+    Complex z   = orbit[m] + dzd;
+    bool    glitched = false;
+
+    // The reference ended during the floatexp iteration
+    if (m + 1 >= length) {
+        if (!isJulia) {
+            dzd = z;
+            m   = 0;
+        }
+        else {
+            glitched = (std::norm(z) <= ESCAPE_RADIUS2);
+        }
+    }
+
+    while (!glitched && n < maxIter && std::norm(z) <= ESCAPE_RADIUS2) {
+
+        size_t l = 0;
+        const BlaTable::Step* step = (bla != nullptr) ?
+            bla->find(m, sqrt(std::norm(dzd)), maxIter - n, &l) : nullptr;
+
+        if (step != nullptr) {
+            dzd = mulMantissas(step->a, dzd) + mulMantissas(step->b, dcd);
+            m += l;
+            n += l;
+        }
+        else {
+            // z(n+1) = z(n)^2 + c expressed for the difference from the
+            // reference
+            dzd = mulMantissas(2.0 * orbit[m] + dzd, dzd) + dcd;
+            m += 1;
+            n += 1;
+        }
+
+        steps++;
+
+        const Complex& Z = orbit[m];
+        z = Z + dzd;
+
+        // Mandelbrot set pixels are rebased to the beginning of the
+        // reference orbit whenever they get closer to zero than to the
+        // reference or the reference escapes. Julia set ones cannot be.
+        if (!isJulia) {
+            if (std::norm(z) < std::norm(dzd) || m + 1 >= length) {
+                dzd = z;
+                m   = 0;
+            }
+        }
+        else {
+            glitched = std::norm(z) < GLITCH_TOLERANCE2 * std::norm(Z) ||
+                       (m + 1 >= length && std::norm(z) <= ESCAPE_RADIUS2);
+        }
+    }
+
+    a_Stats->laneIters += steps;
+    a_Stats->laneSlots += steps;
+
+    if (glitched && n < maxIter) {
+        return GLITCH_VALUE;
+    }
+
+    return smoothIter(float(n), float(z.real()), float(z.imag()), maxIter);
+}
+
+// ============================================================================
+
+void cpuKernelPerturbation (const CpuKernelArgs& a_Args,
+                            size_t a_X0, size_t a_Y0,
+                            size_t a_X1, size_t a_Y1,
+                            float* a_Field,
+                            CpuKernelStats* a_Stats)
+{
+    const CpuPerturbation& perturbation = *a_Args.perturbation;
+
+    // Pixel offsets from the view center on the unit scale, they get the
+    // view scale in floatexp
+    CpuKernelArgs offsetArgs = a_Args;
+    offsetArgs.position[0] = 0.0;
+    offsetArgs.position[1] = 0.0;
+    offsetArgs.scale       = 1.0;
+
+    const CpuKernelMapping<double> mapping (offsetArgs);
+    const bool isJulia = (a_Args.type == FractalType::Julia);
+
+    CpuKernelStats stats;
+
+    for (size_t y=a_Y0; y<a_Y1; ++y) {
+        float* out = a_Field + y * a_Args.width;
+
+        for (size_t x=a_X0; x<a_X1; ++x) {
+            double u, v;
+            mapping.get(x, y, &u, &v);
+
+            ComplexExp offset = perturbation.offset +
+                                ComplexExp(Complex(u, v)) * perturbation.invScale;
+
+            stats.pixels += 1;
+
+            out[x] = isJulia ? iterate(a_Args, offset, ComplexExp(), &stats) :
+                               iterate(a_Args, ComplexExp(), offset, &stats);
+        }
+    }
+
+    if (a_Stats != nullptr) {
+        *a_Stats += stats;
+    }
+}
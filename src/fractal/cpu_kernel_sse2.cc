@@ -0,0 +1,62 @@
+#include "cpu_kernel_impl.hh"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+// ============================================================================
+
+/// SSE2 wrapper, 4x float
+struct Sse2Float {
+    typedef float  Real;
+    typedef __m128 Vec;
+    typedef __m128 Mask;
+
+    static constexpr size_t Width = 4;
+
+    static inline Vec  set1   (Real a)              { return _mm_set1_ps(a); }
+    static inline Vec  load   (const Real* p)       { return _mm_load_ps(p); }
+    static inline void store  (Real* p, Vec a)      { _mm_store_ps(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm_add_ps(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm_sub_ps(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm_mul_ps(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm_cmple_ps(a, b); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm_cmplt_ps(a, b); }
+    static inline Mask land   (Mask a, Mask b)      { return _mm_and_ps(a, b); }
+    static inline Mask lor    (Mask a, Mask b)      { return _mm_or_ps(a, b); }
+    static inline bool any    (Mask m)              { return _mm_movemask_ps(m) != 0; }
+    static inline unsigned bits (Mask m)            { return _mm_movemask_ps(m); }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm_add_ps(n, _mm_and_ps(m, _mm_set1_ps(1.0f))); }
+};
+
+/// SSE2 wrapper, 2x double
+struct Sse2Double {
+    typedef double  Real;
+    typedef __m128d Vec;
+    typedef __m128d Mask;
+
+    static constexpr size_t Width = 2;
+
+    static inline Vec  set1   (Real a)              { return _mm_set1_pd(a); }
+    static inline Vec  load   (const Real* p)       { return _mm_load_pd(p); }
+    static inline void store  (Real* p, Vec a)      { _mm_store_pd(p, a); }
+    static inline Vec  add    (Vec a, Vec b)        { return _mm_add_pd(a, b); }
+    static inline Vec  sub    (Vec a, Vec b)        { return _mm_sub_pd(a, b); }
+    static inline Vec  mul    (Vec a, Vec b)        { return _mm_mul_pd(a, b); }
+    static inline Mask le     (Vec a, Vec b)        { return _mm_cmple_pd(a, b); }
+    static inline Mask lt     (Vec a, Vec b)        { return _mm_cmplt_pd(a, b); }
+    static inline Mask land   (Mask a, Mask b)      { return _mm_and_pd(a, b); }
+    static inline Mask lor    (Mask a, Mask b)      { return _mm_or_pd(a, b); }
+    static inline bool any    (Mask m)              { return _mm_movemask_pd(m) != 0; }
+    static inline unsigned bits (Mask m)            { return _mm_movemask_pd(m); }
+    static inline Vec  select (Mask m, Vec a, Vec b){ return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static inline Vec  inc    (Vec n, Mask m)       { return _mm_add_pd(n, _mm_and_pd(m, _mm_set1_pd(1.0))); }
+};
+
+// ============================================================================
+
+const CpuKernelSet& getCpuKernelsSse2 () {
+    return makeCpuKernelSet<Sse2Float, Sse2Double>();
+}
+
+#endif // __SSE2__
@@ -0,0 +1,128 @@
+#include "cpu_renderer.hh"
+#include "cpu_subdivide.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+CpuRenderer::CpuRenderer (size_t a_Threads) {
+    m_Isa = detectCpuIsa();
+    m_Pool.reset(new TilePool(a_Threads));
+}
+
+// ============================================================================
+
+CpuIsa CpuRenderer::getIsa () const {
+    return m_Isa;
+}
+
+void CpuRenderer::setIsa (CpuIsa a_Isa) {
+    m_Isa = a_Isa;
+}
+
+CpuRefill CpuRenderer::getRefill () const {
+    return m_Refill;
+}
+
+void CpuRenderer::setRefill (CpuRefill a_Refill) {
+    m_Refill    = a_Refill;
+    m_Refilling = false;
+    m_Probe     = 0;
+}
+
+bool CpuRenderer::isRefilled () const {
+    return m_Refilled;
+}
+
+bool CpuRenderer::getSubdivide () const {
+    return m_Subdivide;
+}
+
+void CpuRenderer::setSubdivide (bool a_Subdivide) {
+    m_Subdivide = a_Subdivide;
+}
+
+size_t CpuRenderer::getThreadCount () const {
+    return m_Pool->getThreadCount();
+}
+
+const TilePool& CpuRenderer::getPool () const {
+    return *m_Pool;
+}
+
+// ============================================================================
+
+void CpuRenderer::render (const CpuKernelArgs& a_Args,
+                          bool a_Double,
+                          float* a_Field,
+                          CpuKernelStats* a_Stats)
+{
+    bool refill = (m_Refill == CpuRefill::On);
+
+    // Only plain renders tell the idle lanes, with refill in use a plain
+    // one measures them again now and then
+    if (m_Refill == CpuRefill::Auto) {
+        refill = m_Refilling && m_Probe < REFILL_PROBE;
+        m_Probe = refill ? m_Probe + 1 : 0;
+    }
+
+    CpuKernelStats stats;
+    render(a_Args, getCpuKernel(m_Isa, a_Double, refill), a_Field, &stats);
+
+    // Fields filled by subdivision alone tell nothing
+    if (m_Refill == CpuRefill::Auto && !refill && stats.pixels != 0) {
+        double idle = double(stats.laneSlots - stats.laneIters) / double(stats.pixels);
+        m_Refilling = (idle > REFILL_IDLE);
+    }
+
+    // The scalar kernels have no refill
+    m_Refilled = refill && m_Isa != CpuIsa::Generic;
+
+    if (a_Stats != nullptr) {
+        *a_Stats = stats;
+    }
+}
+
+void CpuRenderer::render (const CpuKernelArgs& a_Args,
+                          CpuKernel a_Kernel,
+                          float* a_Field,
+                          CpuKernelStats* a_Stats)
+{
+    // Each thread accumulates its own stats
+    m_Stats.assign(m_Pool->getThreadCount(), CpuKernelStats());
+
+    // Iteration counts vary a lot across the field. Tiles get balanced
+    // among threads by work stealing.
+    size_t tileSize = m_Subdivide ? SUBDIVIDE_TILE_SIZE : TILE_SIZE;
+
+    m_Pool->run(a_Args.width, a_Args.height, tileSize,
+        [&](const TilePool::Tile& a_Tile, size_t a_Thread) {
+            if (m_Subdivide) {
+                cpuSubdivide(a_Kernel, a_Args, a_Tile.x0, a_Tile.y0, a_Tile.x1, a_Tile.y1,
+                             a_Field, &m_Stats[a_Thread]);
+            }
+            else {
+                a_Kernel(a_Args, a_Tile.x0, a_Tile.y0, a_Tile.x1, a_Tile.y1,
+                       a_Field, &m_Stats[a_Thread]);
+            }
+        });
+
+    if (a_Stats != nullptr) {
+        *a_Stats = CpuKernelStats();
+        for (const auto& stats : m_Stats) {
+            *a_Stats += stats;
+        }
+    }
+}
+
+void CpuRenderer::encode (const float* a_Field,
+                          size_t a_Count,
+                          size_t a_MaxIter,
+                          float* a_Values)
+{
+    for (size_t i=0; i<a_Count; ++i) {
+        float n = a_Field[i];
+        a_Values[i] = (n >= float(a_MaxIter)) ? -std::max(n, 1.0f) : n;
+    }
+}
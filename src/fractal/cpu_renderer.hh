@@ -0,0 +1,111 @@
+#ifndef FRACTAL_CPU_RENDERER_HH
+#define FRACTAL_CPU_RENDERER_HH
+
+#include "cpu_kernel.hh"
+
+#include <utils/tile_pool.hh>
+
+#include <vector>
+#include <memory>
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+
+/// Use of the kernels with lane refill
+enum class CpuRefill {
+    /// Never
+    Off,
+    /// Always
+    On,
+    /// When the plain kernels leave many lanes idle
+    Auto
+};
+
+/// Renders the smooth iteration count field on the CPU. This is the
+/// equivalent of the fractal shader pass and does not need OpenGL.
+class CpuRenderer
+{
+public:
+
+    /// Creates the renderer. Zero threads means all available.
+    CpuRenderer (size_t a_Threads = 0);
+
+    /// Returns the instruction set in use
+    CpuIsa getIsa () const;
+    /// Forces an instruction set. It must be supported by the CPU.
+    void   setIsa (CpuIsa a_Isa);
+    /// Returns the use of kernels with lane refill
+    CpuRefill getRefill () const;
+    /// Sets the use of kernels with lane refill
+    void   setRefill (CpuRefill a_Refill);
+    /// Returns true if the last render used kernels with lane refill
+    bool   isRefilled () const;
+    /// Returns true if tiles are rendered by subdivision
+    bool   getSubdivide () const;
+    /// Enables or disables Mariani-Silver subdivision (see cpuSubdivide())
+    void   setSubdivide (bool a_Subdivide);
+    /// Returns the number of threads
+    size_t getThreadCount () const;
+    /// Returns the thread pool. Its stats describe the last render.
+    const TilePool& getPool () const;
+
+    /// Renders the field. It must hold a_Args.width * a_Args.height values.
+    /// Kernel stats are stored to a_Stats if it is not null. With automatic
+    /// refill the idle lanes of plain renders decide whether the next ones
+    /// refill.
+    void render (const CpuKernelArgs& a_Args,
+                 bool a_Double,
+                 float* a_Field,
+                 CpuKernelStats* a_Stats = nullptr);
+    /// Renders the field with the given kernel, e.g. cpuKernelFixed128()
+    void render (const CpuKernelArgs& a_Args,
+                 CpuKernel a_Kernel,
+                 float* a_Field,
+                 CpuKernelStats* a_Stats = nullptr);
+
+    /// Encodes a field for a GL_R32F texture the same way the shaders do it
+    /// (see iter.fsh). Interior pixels get negative counts.
+    static void encode (const float* a_Field,
+                        size_t a_Count,
+                        size_t a_MaxIter,
+                        float* a_Values);
+
+protected:
+
+    /// Tile size in pixels
+    static constexpr size_t TILE_SIZE = 32;
+    /// Tile size in pixels with subdivision. Larger tiles have relatively
+    /// shorter borders so more of them can be filled.
+    static constexpr size_t SUBDIVIDE_TILE_SIZE = 128;
+    /// Idle lane slots per pixel of the plain kernels above which refill
+    /// pays off. Refilling a lane costs about a vector iteration, which
+    /// views with short orbits do not make up for. The dendrite Julia set
+    /// idles under 0.5 slots per pixel and is 35-50% slower with refill,
+    /// boundary-heavy Mandelbrot views idle 8-100 and are up to 75% faster.
+    static constexpr double REFILL_IDLE = 4.0;
+    /// Renders with refill after which a plain one measures the lane
+    /// utilization again
+    static constexpr size_t REFILL_PROBE = 32;
+
+    /// Instruction set
+    CpuIsa m_Isa = CpuIsa::Generic;
+    /// Lane refill use
+    CpuRefill m_Refill = CpuRefill::Auto;
+    /// Automatic refill state, refill pays off for the current view
+    bool   m_Refilling = false;
+    /// Renders with refill since the last plain one
+    size_t m_Probe = 0;
+    /// Refill was used by the last render
+    bool   m_Refilled = false;
+    /// Subdivision flag
+    bool   m_Subdivide = false;
+    /// Thread pool
+    std::unique_ptr<TilePool> m_Pool;
+
+    /// Per thread kernel stats
+    std::vector<CpuKernelStats> m_Stats;
+};
+
+#endif // FRACTAL_CPU_RENDERER_HH
@@ -0,0 +1,110 @@
+#include "cpu_subdivide.hh"
+
+// ============================================================================
+
+/// Rectangles with a side up to this size are computed directly
+static constexpr size_t MIN_SIZE = 16;
+
+/// Returns true if all border pixels of a rectangle are interior
+static bool isBorderInterior (const CpuKernelArgs& a_Args,
+                              size_t a_X0, size_t a_Y0,
+                              size_t a_X1, size_t a_Y1,
+                              const float* a_Field)
+{
+    const float  maxIter = float(a_Args.maxIter);
+    const float* row0    = a_Field + a_Y0 * a_Args.width;
+    const float* row1    = a_Field + (a_Y1 - 1) * a_Args.width;
+
+    for (size_t x=a_X0; x<a_X1; ++x) {
+        if (row0[x] < maxIter || row1[x] < maxIter) {
+            return false;
+        }
+    }
+
+    for (size_t y=a_Y0+1; y<a_Y1-1; ++y) {
+        const float* row = a_Field + y * a_Args.width;
+        if (row[a_X0] < maxIter || row[a_X1 - 1] < maxIter) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Processes a rectangle whose border has already been computed
+static void subdivide (CpuKernel a_Kernel,
+                       const CpuKernelArgs& a_Args,
+                       size_t a_X0, size_t a_Y0,
+                       size_t a_X1, size_t a_Y1,
+                       float* a_Field,
+                       CpuKernelStats* a_Stats)
+{
+    // Nothing inside the border
+    if (a_X1 - a_X0 <= 2 || a_Y1 - a_Y0 <= 2) {
+        return;
+    }
+
+    // Fill
+    if (isBorderInterior(a_Args, a_X0, a_Y0, a_X1, a_Y1, a_Field)) {
+        for (size_t y=a_Y0+1; y<a_Y1-1; ++y) {
+            float* row = a_Field + y * a_Args.width;
+            for (size_t x=a_X0+1; x<a_X1-1; ++x) {
+                row[x] = float(a_Args.maxIter);
+            }
+        }
+
+        a_Stats->filled += (a_X1 - a_X0 - 2) * (a_Y1 - a_Y0 - 2);
+        return;
+    }
+
+    // Compute small rectangles directly
+    if (a_X1 - a_X0 <= MIN_SIZE || a_Y1 - a_Y0 <= MIN_SIZE) {
+        a_Kernel(a_Args, a_X0 + 1, a_Y0 + 1, a_X1 - 1, a_Y1 - 1, a_Field, a_Stats);
+        return;
+    }
+
+    // Compute the cross splitting the rectangle
+    const size_t xm = (a_X0 + a_X1) / 2;
+    const size_t ym = (a_Y0 + a_Y1) / 2;
+
+    a_Kernel(a_Args, xm,        a_Y0 + 1, xm + 1,   a_Y1 - 1, a_Field, a_Stats);
+    a_Kernel(a_Args, a_X0 + 1,  ym,       xm,       ym + 1,   a_Field, a_Stats);
+    a_Kernel(a_Args, xm + 1,    ym,       a_X1 - 1, ym + 1,   a_Field, a_Stats);
+
+    // Recurse. Parts share the cross.
+    subdivide(a_Kernel, a_Args, a_X0, a_Y0, xm + 1, ym + 1, a_Field, a_Stats);
+    subdivide(a_Kernel, a_Args, xm,   a_Y0, a_X1,   ym + 1, a_Field, a_Stats);
+    subdivide(a_Kernel, a_Args, a_X0, ym,   xm + 1, a_Y1,   a_Field, a_Stats);
+    subdivide(a_Kernel, a_Args, xm,   ym,   a_X1,   a_Y1,   a_Field, a_Stats);
+}
+
+// ============================================================================
+
+void cpuSubdivide (CpuKernel a_Kernel,
+                   const CpuKernelArgs& a_Args,
+                   size_t a_X0, size_t a_Y0,
+                   size_t a_X1, size_t a_Y1,
+                   float* a_Field,
+                   CpuKernelStats* a_Stats)
+{
+    CpuKernelStats stats;
+
+    // Too small to have an inside
+    if (a_X1 - a_X0 <= 2 || a_Y1 - a_Y0 <= 2) {
+        a_Kernel(a_Args, a_X0, a_Y0, a_X1, a_Y1, a_Field, &stats);
+    }
+
+    // Compute the border, then subdivide
+    else {
+        a_Kernel(a_Args, a_X0,     a_Y0,     a_X1,     a_Y0 + 1, a_Field, &stats);
+        a_Kernel(a_Args, a_X0,     a_Y1 - 1, a_X1,     a_Y1,     a_Field, &stats);
+        a_Kernel(a_Args, a_X0,     a_Y0 + 1, a_X0 + 1, a_Y1 - 1, a_Field, &stats);
+        a_Kernel(a_Args, a_X1 - 1, a_Y0 + 1, a_X1,     a_Y1 - 1, a_Field, &stats);
+
+        subdivide(a_Kernel, a_Args, a_X0, a_Y0, a_X1, a_Y1, a_Field, &stats);
+    }
+
+    if (a_Stats != nullptr) {
+        *a_Stats += stats;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef FRACTAL_CPU_SUBDIVIDE_HH
+#define FRACTAL_CPU_SUBDIVIDE_HH
+
+#include "cpu_kernel.hh"
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Renders the [a_X0, a_X1) x [a_Y0, a_Y1) rectangle of the field by
+/// Mariani-Silver subdivision. The border of a rectangle is computed first.
+/// If all of it is interior the rest of the rectangle is filled as interior
+/// without iterating, otherwise the rectangle is split into four by a
+/// computed cross and each part is processed the same way. Small rectangles
+/// are computed directly.
+///
+/// Only interior borders are filled. The field holds smooth iteration counts
+/// which are never uniform outside of the set. Filling is exact for the
+/// Mandelbrot set and connected Julia sets as they have no holes; for the
+/// others a tiny escaping island inside an interior border can be missed.
+void cpuSubdivide (CpuKernel a_Kernel,
+                   const CpuKernelArgs& a_Args,
+                   size_t a_X0, size_t a_Y0,
+                   size_t a_X1, size_t a_Y1,
+                   float* a_Field,
+                   CpuKernelStats* a_Stats);
+
+#endif // FRACTAL_CPU_SUBDIVIDE_HH
@@ -0,0 +1,46 @@
+#include "fixed128.hh"
+#include "big_float.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+Fixed128::Fixed128 (double a_Value) {
+
+    // Zero for NaN
+    if (a_Value != a_Value) {
+        return;
+    }
+
+    // The magnitude is converted, the integer part of the high limb and the
+    // rest are exact in doubles
+    double m = std::min(std::fabs(a_Value), 8.0);
+    m = std::ldexp(m, 60);
+    double h = std::floor(m);
+
+    // Saturate
+    if (h >= std::ldexp(1.0, 63)) {
+        hi = ~(uint64_t(1) << 63);
+        lo = ~uint64_t(0);
+    }
+    else {
+        hi = uint64_t(h);
+        lo = uint64_t(std::ldexp(m - h, 64));
+    }
+
+    if (a_Value < 0.0) {
+        *this = -*this;
+    }
+}
+
+Fixed128::Fixed128 (const BigFloat& a_Value) {
+
+    // Peel off doubles, three of them hold more than 124 bits
+    BigFloat rest = a_Value;
+    for (int i=0; i<3; ++i) {
+        double d = double(rest);
+        *this = *this + Fixed128(d);
+        rest  = rest - BigFloat(d);
+    }
+}
@@ -0,0 +1,200 @@
+#ifndef FRACTAL_FIXED128_HH
+#define FRACTAL_FIXED128_HH
+
+#include <cstdint>
+
+class BigFloat;
+
+// ============================================================================
+
+/// A signed Q4.124 fixed-point number in two's complement, held in two 64-bit
+/// limbs. It represents [-8, 8) with a resolution of 2^-124. Nothing checks
+/// for overflow, the user keeps values in range.
+///
+/// Products are truncated towards zero. Where the compiler has 128-bit
+/// integers a 64x64 bit limb product is a single instruction, otherwise it
+/// is composed of 32-bit products.
+struct Fixed128
+{
+    /// Bits below the binary point
+    static constexpr int FRACTION_BITS = 124;
+
+    /// Values of the least significant bits of the limbs
+    static constexpr double HI_UNIT = 1.0 / double(uint64_t(1) << 60);
+    static constexpr double LO_UNIT = HI_UNIT * HI_UNIT / 16.0;
+
+    /// Low limb
+    uint64_t lo = 0;
+    /// High limb, its top bit is the sign
+    uint64_t hi = 0;
+
+    /// Zero
+    Fixed128 () {};
+    /// Conversion from a double, truncated. Values out of range saturate.
+    explicit Fixed128 (double a_Value);
+    /// Conversion from an arbitrary precision number, within a few units of
+    /// the last place. Values out of range saturate.
+    explicit Fixed128 (const BigFloat& a_Value);
+
+    /// Returns true for negative numbers
+    bool isNegative () const {
+        return (hi >> 63) != 0;
+    }
+
+    /// Conversion to a double. Magnitudes are converted so that small
+    /// negative numbers keep their precision.
+    explicit operator double () const;
+
+    /// Returns the value within 2^-60 from the high limb only, much cheaper
+    /// than the conversion
+    double getCoarse () const {
+        return double(int64_t(hi)) * HI_UNIT;
+    }
+};
+
+// ============================================================================
+
+/// 64x64 bit product, the high limb is stored to a_Hi
+static inline uint64_t mulWide (uint64_t a, uint64_t b, uint64_t* a_Hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    *a_Hi = uint64_t(p >> 64);
+    return uint64_t(p);
+#else
+    uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+    uint64_t b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+
+    uint64_t p00 = a0 * b0;
+    uint64_t p01 = a0 * b1;
+    uint64_t p10 = a1 * b0;
+    uint64_t p11 = a1 * b1;
+
+    uint64_t mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+
+    *a_Hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xFFFFFFFFu);
+#endif
+}
+
+static inline Fixed128 operator + (const Fixed128& a, const Fixed128& b) {
+    Fixed128 r;
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi + (r.lo < a.lo);
+    return r;
+}
+
+static inline Fixed128 operator - (const Fixed128& a, const Fixed128& b) {
+    Fixed128 r;
+    r.lo = a.lo - b.lo;
+    r.hi = a.hi - b.hi - (a.lo < b.lo);
+    return r;
+}
+
+static inline Fixed128 operator - (const Fixed128& a) {
+    return Fixed128() - a;
+}
+
+/// Negates a number if a_Mask is all ones, leaves it if it is zero
+static inline Fixed128 negateIf (const Fixed128& a, uint64_t a_Mask) {
+    Fixed128 r;
+    r.lo = (a.lo ^ a_Mask) - a_Mask;
+    r.hi = (a.hi ^ a_Mask) + ((a_Mask & 1) & (r.lo == 0));
+    return r;
+}
+
+/// Returns all ones for negative numbers, zero otherwise
+static inline uint64_t signMask (const Fixed128& a) {
+    return uint64_t(int64_t(a.hi) >> 63);
+}
+
+inline Fixed128::operator double () const {
+    if (!isNegative()) {
+        return double(hi) * HI_UNIT + double(lo) * LO_UNIT;
+    }
+
+    uint64_t l = ~lo + 1;
+    uint64_t h = ~hi + (l == 0);
+    return -(double(h) * HI_UNIT + double(l) * LO_UNIT);
+}
+
+/// Multiplication by two
+static inline Fixed128 twice (const Fixed128& a) {
+    Fixed128 r;
+    r.lo = a.lo << 1;
+    r.hi = (a.hi << 1) | (a.lo >> 63);
+    return r;
+}
+
+/// Takes bits 124..251 of a 256-bit product
+static inline Fixed128 fromProduct (uint64_t p1, uint64_t p2, uint64_t p3) {
+    Fixed128 r;
+    r.lo = (p1 >> 60) | (p2 << 4);
+    r.hi = (p2 >> 60) | (p3 << 4);
+    return r;
+}
+
+/// Product of magnitudes
+static inline Fixed128 mulMagnitudes (const Fixed128& a, const Fixed128& b) {
+
+    uint64_t h00, h01, h10, h11;
+    mulWide(a.lo, b.lo, &h00);
+    uint64_t l01 = mulWide(a.lo, b.hi, &h01);
+    uint64_t l10 = mulWide(a.hi, b.lo, &h10);
+    uint64_t l11 = mulWide(a.hi, b.hi, &h11);
+
+    // Limb 1, the low limb of a.lo * b.lo only matters as it is below
+    uint64_t p1 = h00 + l01;
+    uint64_t c1 = (p1 < h00);
+    p1 += l10;
+    c1 += (p1 < l10);
+
+    // Limb 2
+    uint64_t p2 = h01 + c1;
+    uint64_t c2 = (p2 < c1);
+    p2 += h10;
+    c2 += (p2 < h10);
+    p2 += l11;
+    c2 += (p2 < l11);
+
+    // Limb 3
+    uint64_t p3 = h11 + c2;
+
+    return fromProduct(p1, p2, p3);
+}
+
+/// Signs are handled without branches, they are unpredictable in orbits
+static inline Fixed128 operator * (const Fixed128& a, const Fixed128& b) {
+    uint64_t sa = signMask(a);
+    uint64_t sb = signMask(b);
+    return negateIf(mulMagnitudes(negateIf(a, sa), negateIf(b, sb)), sa ^ sb);
+}
+
+/// Square, one limb product less than a multiplication
+static inline Fixed128 sqr (const Fixed128& a) {
+
+    Fixed128 m = negateIf(a, signMask(a));
+
+    uint64_t h00, h01, h11;
+    mulWide(m.lo, m.lo, &h00);
+    uint64_t l01 = mulWide(m.lo, m.hi, &h01);
+    uint64_t l11 = mulWide(m.hi, m.hi, &h11);
+
+    // The cross product appears twice
+    uint64_t c01 = h01 >> 63;
+    h01 = (h01 << 1) | (l01 >> 63);
+    l01 = (l01 << 1);
+
+    uint64_t p1 = h00 + l01;
+    uint64_t c1 = (p1 < h00);
+
+    uint64_t p2 = h01 + c1;
+    uint64_t c2 = (p2 < c1);
+    p2 += l11;
+    c2 += (p2 < l11);
+
+    uint64_t p3 = h11 + c2 + c01;
+
+    return fromProduct(p1, p2, p3);
+}
+
+#endif // FRACTAL_FIXED128_HH
@@ -0,0 +1,87 @@
+#include "float_exp.hh"
+#include "big_float.hh"
+
+#include <algorithm>
+
+// ============================================================================
+
+FloatExp::FloatExp (const BigFloat& a_Value) {
+
+    if (a_Value.isZero()) {
+        return;
+    }
+
+    int64_t e = a_Value.getExponent();
+    *this = FloatExp(double(ldexp(a_Value, -e)), e);
+}
+
+// ============================================================================
+
+bool operator < (const FloatExp& a, const FloatExp& b) {
+    return (a - b).m_Mantissa < 0.0;
+}
+
+bool operator <= (const FloatExp& a, const FloatExp& b) {
+    return (a - b).m_Mantissa <= 0.0;
+}
+
+FloatExp ldexp (const FloatExp& a, int64_t e) {
+    FloatExp r = a;
+    if (r.m_Mantissa != 0.0) {
+        r.m_Exponent += e;
+    }
+    return r;
+}
+
+FloatExp fabs (const FloatExp& a) {
+    FloatExp r = a;
+    r.m_Mantissa = std::fabs(r.m_Mantissa);
+    return r;
+}
+
+// ============================================================================
+
+ComplexExp::ComplexExp (const FloatExp& a_Real) :
+    m_Mantissa (a_Real.getMantissa(), 0.0),
+    m_Exponent (a_Real.getExponent())
+{
+    // Empty, already normalized
+}
+
+ComplexExp::ComplexExp (const FloatExp& a_Real, const FloatExp& a_Imag) {
+
+    // The larger exponent of the nonzero parts
+    int64_t e = std::max(a_Real.getExponent(), a_Imag.getExponent());
+    if (a_Real.getMantissa() == 0.0) {
+        e = a_Imag.getExponent();
+    }
+    if (a_Imag.getMantissa() == 0.0) {
+        e = a_Real.getExponent();
+    }
+
+    m_Mantissa = Complex(
+        a_Real.getMantissa() * pow2(a_Real.getExponent() - e),
+        a_Imag.getMantissa() * pow2(a_Imag.getExponent() - e)
+        );
+    m_Exponent = e;
+
+    normalize();
+}
+
+// ============================================================================
+
+FloatExp norm (const ComplexExp& a) {
+    return FloatExp(std::norm(a.m_Mantissa), 2 * a.m_Exponent);
+}
+
+FloatExp abs (const ComplexExp& a) {
+    return FloatExp(std::abs(a.m_Mantissa), a.m_Exponent);
+}
+
+ComplexExp ldexp (const ComplexExp& a, int64_t e) {
+    ComplexExp r = a;
+    if (r.m_Mantissa != ComplexExp::Complex(0.0, 0.0)) {
+        r.m_Exponent += e;
+    }
+    return r;
+}
@@ -0,0 +1,431 @@
+#ifndef FRACTAL_FLOAT_EXP_HH
+#define FRACTAL_FLOAT_EXP_HH
+
+#include <complex>
+#include <algorithm>
+
+#include <cmath>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+class BigFloat;
+
+// ============================================================================
+
+/// Returns 2^e as a double, zero or infinity out of the normal range
+static inline double pow2 (int64_t e) {
+
+    if (e < -1022) {
+        return 0.0;
+    }
+    if (e > 1023) {
+        return INFINITY;
+    }
+
+    uint64_t bits = uint64_t(e + 1023) << 52;
+    double   value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/// Returns a_Value * 2^e, also where 2^e itself is out of the double range
+static inline double mulPow2 (double a_Value, int64_t e) {
+
+    if (e < -1022 || e > 1023) {
+        return a_Value * pow2(e / 2) * pow2(e - e / 2);
+    }
+
+    return a_Value * pow2(e);
+}
+
+/// Returns true unless a double is infinity or NaN. Tests the exponent
+/// field as comparisons with infinity fold away under -ffast-math.
+static inline bool isFiniteDouble (double a_Value) {
+
+    uint64_t bits;
+    memcpy(&bits, &a_Value, sizeof(bits));
+    return ((bits >> 52) & 0x7FF) != 0x7FF;
+}
+
+/// Returns the exponent of a normal nonzero double, the value is in
+/// [2^(e-1), 2^e) in magnitude
+static inline int64_t getDoubleExponent (double a_Value) {
+
+    uint64_t bits;
+    memcpy(&bits, &a_Value, sizeof(bits));
+    return int64_t((bits >> 52) & 0x7FF) - 1022;
+}
+
+/// Scales a mantissa into [0.5, 1) in magnitude and adjusts the exponent.
+/// Zero gets the exponent zero, infinity and NaN are left as they are.
+static inline void normalizeParts (double& a_Mantissa, int64_t& a_Exponent) {
+
+    double m = a_Mantissa;
+
+    if (m == 0.0) {
+        a_Exponent = 0;
+        return;
+    }
+    if (!isFiniteDouble(m)) {
+        return;
+    }
+
+    // Subnormals have no implicit bit, make them normal first
+    if (std::fabs(m) < DBL_MIN) {
+        m *= pow2(64);
+        a_Exponent -= 64;
+    }
+
+    // Replace the exponent field, the value gets into [0.5, 1)
+    uint64_t bits;
+    memcpy(&bits, &m, sizeof(bits));
+
+    a_Exponent += int64_t((bits >> 52) & 0x7FF) - 1022;
+    bits = (bits & ~(uint64_t(0x7FF) << 52)) | (uint64_t(1022) << 52);
+
+    memcpy(&a_Mantissa, &bits, sizeof(bits));
+}
+
+// ============================================================================
+
+/// A floating point number with a double mantissa and a separate 64-bit
+/// exponent (floatexp). The value is
+///
+///  mantissa * 2^exponent
+///
+/// with the mantissa in [0.5, 1) in magnitude or zero. It has the
+/// precision of a double and practically no exponent range limit, it holds
+/// pixel offsets of views far beyond 1e-308. Results are normalized with
+/// bit operations, there are no calls to frexp() and ldexp().
+class FloatExp
+{
+public:
+
+    /// Zero
+    FloatExp () {};
+    /// Conversion from a double
+    FloatExp (double a_Value) : FloatExp(a_Value, 0) {};
+    /// A mantissa times 2^a_Exponent, normalized
+    FloatExp (double a_Mantissa, int64_t a_Exponent) :
+        m_Mantissa (a_Mantissa),
+        m_Exponent (a_Exponent)
+    {
+        normalizeParts(m_Mantissa, m_Exponent);
+    }
+    /// Conversion from an arbitrary precision number, rounded to a double
+    /// mantissa
+    explicit FloatExp (const BigFloat& a_Value);
+
+    /// Returns the mantissa
+    double  getMantissa () const { return m_Mantissa; }
+    /// Returns the exponent
+    int64_t getExponent () const { return m_Exponent; }
+
+    /// Conversion to a double. Values out of the double range become zero
+    /// or infinity.
+    explicit operator double () const {
+        return mulPow2(m_Mantissa, m_Exponent);
+    }
+
+    /// Arithmetic
+    friend FloatExp operator + (const FloatExp& a, const FloatExp& b);
+    friend FloatExp operator - (const FloatExp& a, const FloatExp& b);
+    friend FloatExp operator * (const FloatExp& a, const FloatExp& b);
+    friend FloatExp operator / (const FloatExp& a, const FloatExp& b);
+    friend FloatExp operator - (const FloatExp& a);
+
+    /// Comparison
+    friend bool operator <  (const FloatExp& a, const FloatExp& b);
+    friend bool operator <= (const FloatExp& a, const FloatExp& b);
+
+    /// Multiplication by a power of two (exact)
+    friend FloatExp ldexp (const FloatExp& a, int64_t e);
+    /// Absolute value
+    friend FloatExp fabs  (const FloatExp& a);
+
+protected:
+
+    /// Mantissa
+    double  m_Mantissa = 0.0;
+    /// Exponent
+    int64_t m_Exponent = 0;
+};
+
+// ============================================================================
+
+/// A complex number in floatexp. Both parts share the exponent so the
+/// mantissas are added and multiplied as a pair, the larger one is in
+/// [0.5, 1) in magnitude.
+class ComplexExp
+{
+public:
+
+    /// Complex number type of the mantissas
+    typedef std::complex<double> Complex;
+
+    /// Zero
+    ComplexExp () {};
+    /// A mantissa times 2^a_Exponent, normalized
+    ComplexExp (const Complex& a_Mantissa, int64_t a_Exponent);
+    /// Conversion from a complex double
+    explicit ComplexExp (const Complex& a_Value) : ComplexExp(a_Value, 0) {};
+    /// A real number
+    explicit ComplexExp (const FloatExp& a_Real);
+    /// Composition of the real and imaginary parts
+    ComplexExp (const FloatExp& a_Real, const FloatExp& a_Imag);
+
+    /// Returns the mantissa
+    const Complex& getMantissa () const { return m_Mantissa; }
+    /// Returns the exponent
+    int64_t getExponent () const { return m_Exponent; }
+
+    /// Conversion to a complex double. Parts out of the double range become
+    /// zero or infinity.
+    explicit operator Complex () const {
+        return Complex(mulPow2(m_Mantissa.real(), m_Exponent),
+                       mulPow2(m_Mantissa.imag(), m_Exponent));
+    }
+
+    /// Arithmetic
+    friend ComplexExp operator + (const ComplexExp& a, const ComplexExp& b);
+    friend ComplexExp operator - (const ComplexExp& a, const ComplexExp& b);
+    friend ComplexExp operator * (const ComplexExp& a, const ComplexExp& b);
+    friend ComplexExp operator * (const ComplexExp& a, const Complex& b);
+    friend ComplexExp operator * (const ComplexExp& a, const FloatExp& b);
+    friend ComplexExp operator / (const ComplexExp& a, const FloatExp& b);
+
+    ComplexExp& operator += (const ComplexExp& a) {
+        return *this = *this + a;
+    }
+
+    /// Sum of products a[i] * b[n-1-i] for i in [0, n). The products are
+    /// aligned to the largest exponent and summed as plain complex doubles
+    /// with one normalization at the end.
+    friend ComplexExp convolve (const ComplexExp* a, const ComplexExp* b, size_t n);
+
+    /// Squared magnitude
+    friend FloatExp norm (const ComplexExp& a);
+    /// Magnitude
+    friend FloatExp abs  (const ComplexExp& a);
+    /// Multiplication by a power of two (exact)
+    friend ComplexExp ldexp (const ComplexExp& a, int64_t e);
+
+protected:
+
+    /// Normalizes the mantissa
+    void normalize ();
+    /// Returns a normalized result of arithmetic. The mantissa is zero or
+    /// not far from 1 in magnitude so it takes no range checks.
+    static ComplexExp result (const Complex& a_Mantissa, int64_t a_Exponent);
+
+    /// Mantissa
+    Complex m_Mantissa;
+    /// Exponent
+    int64_t m_Exponent = 0;
+};
+
+// ============================================================================
+
+inline FloatExp operator + (const FloatExp& a, const FloatExp& b) {
+
+    if (a.m_Mantissa == 0.0) {
+        return b;
+    }
+    if (b.m_Mantissa == 0.0) {
+        return a;
+    }
+
+    // Align to the larger exponent. The smaller number vanishes once it is
+    // far enough below.
+    if (a.m_Exponent >= b.m_Exponent) {
+        double m = a.m_Mantissa + b.m_Mantissa * pow2(b.m_Exponent - a.m_Exponent);
+        return FloatExp(m, a.m_Exponent);
+    }
+    else {
+        double m = b.m_Mantissa + a.m_Mantissa * pow2(a.m_Exponent - b.m_Exponent);
+        return FloatExp(m, b.m_Exponent);
+    }
+}
+
+inline FloatExp operator - (const FloatExp& a, const FloatExp& b) {
+    return a + (-b);
+}
+
+inline FloatExp operator * (const FloatExp& a, const FloatExp& b) {
+    return FloatExp(a.m_Mantissa * b.m_Mantissa, a.m_Exponent + b.m_Exponent);
+}
+
+inline FloatExp operator / (const FloatExp& a, const FloatExp& b) {
+    return FloatExp(a.m_Mantissa / b.m_Mantissa, a.m_Exponent - b.m_Exponent);
+}
+
+inline FloatExp operator - (const FloatExp& a) {
+    FloatExp r = a;
+    r.m_Mantissa = -r.m_Mantissa;
+    return r;
+}
+
+// ============================================================================
+
+inline ComplexExp::ComplexExp (const Complex& a_Mantissa, int64_t a_Exponent) :
+    m_Mantissa (a_Mantissa),
+    m_Exponent (a_Exponent)
+{
+    normalize();
+}
+
+inline void ComplexExp::normalize () {
+
+    double re = m_Mantissa.real();
+    double im = m_Mantissa.imag();
+    double m  = std::max(std::fabs(re), std::fabs(im));
+
+    if (m == 0.0) {
+        m_Exponent = 0;
+        return;
+    }
+    if (!isFiniteDouble(m)) {
+        return;
+    }
+
+    // Both parts are scaled by the same power of two, the exponent comes
+    // from the larger one
+    if (m < DBL_MIN) {
+        re *= pow2(64);
+        im *= pow2(64);
+        m  *= pow2(64);
+        m_Exponent -= 64;
+    }
+
+    int64_t e = getDoubleExponent(m);
+    m_Mantissa = Complex(mulPow2(re, -e), mulPow2(im, -e));
+    m_Exponent += e;
+}
+
+inline ComplexExp ComplexExp::result (const Complex& a_Mantissa, int64_t a_Exponent) {
+
+    ComplexExp r;
+    double m = std::max(std::fabs(a_Mantissa.real()), std::fabs(a_Mantissa.imag()));
+
+    if (m != 0.0) {
+        int64_t e = getDoubleExponent(m);
+        r.m_Mantissa = a_Mantissa * pow2(-e);
+        r.m_Exponent = a_Exponent + e;
+    }
+
+    return r;
+}
+
+// ============================================================================
+
+inline ComplexExp operator + (const ComplexExp& a, const ComplexExp& b) {
+
+    if (a.m_Mantissa == ComplexExp::Complex(0.0, 0.0)) {
+        return b;
+    }
+    if (b.m_Mantissa == ComplexExp::Complex(0.0, 0.0)) {
+        return a;
+    }
+
+    // Align to the larger exponent, both parts at once
+    if (a.m_Exponent >= b.m_Exponent) {
+        double s = pow2(b.m_Exponent - a.m_Exponent);
+        return ComplexExp::result(a.m_Mantissa + b.m_Mantissa * s, a.m_Exponent);
+    }
+    else {
+        double s = pow2(a.m_Exponent - b.m_Exponent);
+        return ComplexExp::result(b.m_Mantissa + a.m_Mantissa * s, b.m_Exponent);
+    }
+}
+
+inline ComplexExp operator - (const ComplexExp& a, const ComplexExp& b) {
+    ComplexExp n = b;
+    n.m_Mantissa = -n.m_Mantissa;
+    return a + n;
+}
+
+/// Complex product of mantissas without the checks for infinities of the
+/// standard one
+static inline ComplexExp::Complex mulMantissas (const ComplexExp::Complex& a,
+                                                const ComplexExp::Complex& b)
+{
+    return ComplexExp::Complex(
+        a.real() * b.real() - a.imag() * b.imag(),
+        a.real() * b.imag() + a.imag() * b.real()
+        );
+}
+
+inline ComplexExp operator * (const ComplexExp& a, const ComplexExp& b) {
+    return ComplexExp::result(mulMantissas(a.m_Mantissa, b.m_Mantissa), a.m_Exponent + b.m_Exponent);
+}
+
+inline ComplexExp operator * (const ComplexExp& a, const ComplexExp::Complex& b) {
+    return ComplexExp(mulMantissas(a.m_Mantissa, b), a.m_Exponent);
+}
+
+inline ComplexExp operator * (const ComplexExp& a, const FloatExp& b) {
+    return ComplexExp::result(a.m_Mantissa * b.getMantissa(), a.m_Exponent + b.getExponent());
+}
+
+inline ComplexExp operator / (const ComplexExp& a, const FloatExp& b) {
+    return ComplexExp::result(a.m_Mantissa / b.getMantissa(), a.m_Exponent - b.getExponent());
+}
+
+inline ComplexExp convolve (const ComplexExp* a, const ComplexExp* b, size_t n) {
+
+    // The largest exponent of nonzero products, zeros have the exponent 0
+    bool    any = false;
+    int64_t e   = 0;
+    for (size_t i=0; i<n; ++i) {
+        const ComplexExp& x = a[i];
+        const ComplexExp& y = b[n - 1 - i];
+
+        if (x.m_Mantissa == ComplexExp::Complex(0.0, 0.0) ||
+            y.m_Mantissa == ComplexExp::Complex(0.0, 0.0))
+        {
+            continue;
+        }
+
+        int64_t ei = x.m_Exponent + y.m_Exponent;
+        e   = any ? std::max(e, ei) : ei;
+        any = true;
+    }
+
+    if (!any) {
+        return ComplexExp();
+    }
+
+    // Products of mantissas are below 2 in magnitude, the sum of a few of
+    // them needs no range checks. The loop has no branches, the scale of
+    // zero products is clamped so that they stay zero.
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t i=0; i<n; ++i) {
+        const ComplexExp& x = a[i];
+        const ComplexExp& y = b[n - 1 - i];
+
+        double s = pow2(std::min<int64_t>(x.m_Exponent + y.m_Exponent - e, 0));
+        re += (x.m_Mantissa.real() * y.m_Mantissa.real() -
+               x.m_Mantissa.imag() * y.m_Mantissa.imag()) * s;
+        im += (x.m_Mantissa.real() * y.m_Mantissa.imag() +
+               x.m_Mantissa.imag() * y.m_Mantissa.real()) * s;
+    }
+
+    // Cancellation may leave a subnormal sum, the full normalization
+    // handles it
+    return ComplexExp(ComplexExp::Complex(re, im), e);
+}
+
+// ============================================================================
+
+static inline ComplexExp operator * (const ComplexExp::Complex& a, const ComplexExp& b) {
+    return b * a;
+}
+
+static inline ComplexExp operator + (const ComplexExp::Complex& a, const ComplexExp& b) {
+    return ComplexExp(a) + b;
+}
+
+#endif // FRACTAL_FLOAT_EXP_HH
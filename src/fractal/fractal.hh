@@ -0,0 +1,25 @@
+#ifndef FRACTAL_FRACTAL_HH
+#define FRACTAL_FRACTAL_HH
+
+// ============================================================================
+
+/// Fractal type
+enum class FractalType {
+    Mandelbrot,
+    Julia
+};
+
+/// Interior checks. Pixels found to be inside the set by any of them stop
+/// iterating early. Shaders get them as a bit mask too.
+enum InteriorCheck : unsigned {
+    /// Main cardioid and period-2 bulb test (Mandelbrot set only)
+    INTERIOR_BULBS       = 1 << 0,
+    /// Orbit periodicity detection
+    INTERIOR_PERIODICITY = 1 << 1,
+    /// Orbit derivative vanishing over a period
+    INTERIOR_DERIVATIVE  = 1 << 2,
+
+    INTERIOR_ALL         = INTERIOR_BULBS | INTERIOR_PERIODICITY | INTERIOR_DERIVATIVE
+};
+
+#endif // FRACTAL_FRACTAL_HH
@@ -0,0 +1,144 @@
+#include "precision_ladder.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+const char* getFractalPrecisionName (FractalPrecision a_Precision) {
+
+    switch (a_Precision)
+    {
+    case FractalPrecision::Fp32:         return "fp32";
+    case FractalPrecision::DoubleFloat:  return "double-float";
+    case FractalPrecision::Fp64:         return "fp64";
+    case FractalPrecision::Fixed128:     return "fixed128";
+    case FractalPrecision::Perturbation: return "perturbation";
+    }
+
+    return "unknown";
+}
+
+// ============================================================================
+
+PrecisionLadder::PrecisionLadder () {
+
+    // Until measured assume that every rung doubles the cost
+    for (size_t i=0; i<COUNT; ++i) {
+        m_Rungs[i].available = true;
+        m_Rungs[i].cost      = double(1 << i);
+    }
+}
+
+// ============================================================================
+
+void PrecisionLadder::setAvailable (FractalPrecision a_Precision, bool a_Available) {
+
+    // Perturbation is the last resort
+    if (a_Precision == FractalPrecision::Perturbation) {
+        return;
+    }
+
+    m_Rungs[size_t(a_Precision)].available = a_Available;
+}
+
+bool PrecisionLadder::isAvailable (FractalPrecision a_Precision) const {
+    return m_Rungs[size_t(a_Precision)].available;
+}
+
+void PrecisionLadder::setCost (FractalPrecision a_Precision, double a_Cost) {
+    m_Rungs[size_t(a_Precision)].cost = a_Cost;
+}
+
+double PrecisionLadder::getCost (FractalPrecision a_Precision) const {
+    return m_Rungs[size_t(a_Precision)].cost;
+}
+
+// ============================================================================
+
+double PrecisionLadder::getMantissaBits (FractalPrecision a_Precision) {
+
+    switch (a_Precision)
+    {
+    case FractalPrecision::Fp32:         return 24.0;
+    case FractalPrecision::DoubleFloat:  return 44.0; // Not IEEE exact
+    case FractalPrecision::Fp64:         return 53.0;
+    case FractalPrecision::Fixed128:     return 122.0; // Absolute, up to 4
+    case FractalPrecision::Perturbation: return INFINITY;
+    }
+
+    return 0.0;
+}
+
+double PrecisionLadder::getRequiredBits (const std::array<double, 2>& a_Position,
+                                         double a_Zoom,
+                                         size_t a_Width,
+                                         size_t a_Height)
+{
+    double aspect = double(a_Width) / double(a_Height);
+
+    // The largest coordinate magnitude within the view (any rotation). The
+    // radius underflows to zero at deep zooms, the extent is at least 1.
+    double radius = sqrt(1.0 + 1.0 / (aspect * aspect)) * exp2(-a_Zoom);
+    double extent = std::max(fabs(a_Position[0]), fabs(a_Position[1])) + radius;
+
+    // Orbits reach magnitudes around 1 wherever the view is, it matters for
+    // fixed point whose precision is absolute
+    extent = std::max(extent, 1.0);
+
+    // Pixel spacing is 2 / (width * 2^zoom), taken in logarithms so that it
+    // holds beyond the double range
+    return log2(extent) + a_Zoom + log2(0.5 * double(a_Width));
+}
+
+// ============================================================================
+
+bool PrecisionLadder::covers (FractalPrecision a_Precision,
+                              double a_RequiredBits,
+                              double a_Margin) const
+{
+    if (!isAvailable(a_Precision)) {
+        return false;
+    }
+
+    double bits = getMantissaBits(a_Precision) - GUARD_BITS;
+    return a_RequiredBits + a_Margin <= bits;
+}
+
+FractalPrecision PrecisionLadder::cheapest (double a_RequiredBits, double a_Margin) const {
+
+    FractalPrecision best = FractalPrecision::Perturbation;
+
+    for (size_t i=0; i<COUNT; ++i) {
+        FractalPrecision precision = FractalPrecision(i);
+
+        if (covers(precision, a_RequiredBits, a_Margin) &&
+            getCost(precision) < getCost(best))
+        {
+            best = precision;
+        }
+    }
+
+    return best;
+}
+
+FractalPrecision PrecisionLadder::select (double a_RequiredBits) {
+
+    // The current precision no longer covers the view. Switch immediately.
+    if (!covers(m_Current, a_RequiredBits, 0.0)) {
+        m_Current = cheapest(a_RequiredBits, 0.0);
+        return m_Current;
+    }
+
+    // Switch to a cheaper one only when it covers the view with a margin
+    FractalPrecision candidate = cheapest(a_RequiredBits, HYSTERESIS_BITS);
+    if (getCost(candidate) < getCost(m_Current)) {
+        m_Current = candidate;
+    }
+
+    return m_Current;
+}
+
+FractalPrecision PrecisionLadder::getCurrent () const {
+    return m_Current;
+}
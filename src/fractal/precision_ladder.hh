@@ -0,0 +1,92 @@
+#ifndef FRACTAL_PRECISION_LADDER_HH
+#define FRACTAL_PRECISION_LADDER_HH
+
+#include <array>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Arithmetic the fractal is computed with, from the least precise one
+enum class FractalPrecision {
+    Fp32,
+    DoubleFloat,
+    Fp64,
+    Fixed128,
+    Perturbation
+};
+
+/// Returns a name of a precision
+const char* getFractalPrecisionName (FractalPrecision a_Precision);
+
+// ============================================================================
+
+/// Picks the cheapest fractal kernel whose precision covers the current
+/// view. Kernels are ranked by their relative costs, which are supposed to
+/// be measured at startup. Perturbation is always available and covers any
+/// view the application can zoom to.
+///
+/// To avoid flipping between kernels around a precision limit a cheaper
+/// kernel is only switched to when it covers the view with a margin.
+class PrecisionLadder
+{
+public:
+
+    /// Number of precisions
+    static constexpr size_t COUNT = 5;
+
+    /// Bits of precision kept below the pixel spacing
+    static constexpr double GUARD_BITS = 2.0;
+    /// Additional bits required to switch to a cheaper kernel
+    static constexpr double HYSTERESIS_BITS = 1.0;
+
+    /// Constructor
+    PrecisionLadder ();
+
+    /// Marks a precision as available or not
+    void   setAvailable (FractalPrecision a_Precision, bool a_Available);
+    /// Returns true if a precision is available
+    bool   isAvailable  (FractalPrecision a_Precision) const;
+    /// Sets the relative cost of a precision
+    void   setCost      (FractalPrecision a_Precision, double a_Cost);
+    /// Returns the relative cost of a precision
+    double getCost      (FractalPrecision a_Precision) const;
+
+    /// Returns the number of mantissa bits of a precision
+    static double getMantissaBits (FractalPrecision a_Precision);
+
+    /// Returns the number of bits needed to tell pixels of a view apart.
+    /// The view spans [-1, +1] horizontally divided by 2^a_Zoom.
+    static double getRequiredBits (const std::array<double, 2>& a_Position,
+                                   double a_Zoom,
+                                   size_t a_Width,
+                                   size_t a_Height);
+
+    /// Selects a precision for a view given by the required bits
+    FractalPrecision select (double a_RequiredBits);
+    /// Returns the last selected precision
+    FractalPrecision getCurrent () const;
+
+protected:
+
+    /// Returns true if a precision covers the view with the given margin
+    bool covers (FractalPrecision a_Precision,
+                 double a_RequiredBits,
+                 double a_Margin) const;
+
+    /// Returns the cheapest available precision that covers the view
+    FractalPrecision cheapest (double a_RequiredBits, double a_Margin) const;
+
+    /// A ladder rung
+    struct Rung {
+        bool   available;
+        double cost;
+    };
+
+    /// Rungs
+    std::array<Rung, COUNT> m_Rungs;
+    /// Current precision
+    FractalPrecision m_Current = FractalPrecision::Fp32;
+};
+
+#endif // FRACTAL_PRECISION_LADDER_HH
@@ -0,0 +1,99 @@
+#include "progressive.hh"
+
+#include <algorithm>
+
+// ============================================================================
+
+void FractalProgress::start (size_t a_Width, size_t a_Height) {
+
+    m_Tiles.clear();
+
+    const size_t size = TILE_SIZE;
+
+    for (size_t y=0; y<a_Height; y+=size) {
+        for (size_t x=0; x<a_Width; x+=size) {
+            Tile tile;
+            tile.x      = x;
+            tile.y      = y;
+            tile.width  = std::min(size, a_Width  - x);
+            tile.height = std::min(size, a_Height - y);
+
+            m_Tiles.push_back(tile);
+        }
+    }
+
+    // The center of the screen first
+    auto distance = [&](const Tile& t) {
+        double dx = double(t.x) + 0.5 * double(t.width)  - 0.5 * double(a_Width);
+        double dy = double(t.y) + 0.5 * double(t.height) - 0.5 * double(a_Height);
+        return dx * dx + dy * dy;
+    };
+
+    std::stable_sort(m_Tiles.begin(), m_Tiles.end(),
+        [&](const Tile& a, const Tile& b) {
+            return distance(a) < distance(b);
+        });
+
+    m_Next   = 0;
+    m_Active = true;
+}
+
+void FractalProgress::reset () {
+    m_Tiles.clear();
+    m_Next   = 0;
+    m_Active = false;
+}
+
+// ============================================================================
+
+bool FractalProgress::isActive () const {
+    return m_Active;
+}
+
+bool FractalProgress::isDone () const {
+    return m_Active && m_Next >= m_Tiles.size();
+}
+
+float FractalProgress::getProgress () const {
+    if (m_Tiles.empty()) {
+        return 0.0f;
+    }
+
+    return float(m_Next) / float(m_Tiles.size());
+}
+
+// ============================================================================
+
+bool FractalProgress::next (double a_Elapsed, double a_Budget, Tile* a_Tile) const {
+
+    if (!m_Active || m_Next >= m_Tiles.size()) {
+        return false;
+    }
+
+    const Tile& tile = m_Tiles[m_Next];
+
+    // At least one tile per frame
+    if (a_Elapsed > 0.0) {
+        double cost = m_PixelCost * double(tile.width * tile.height);
+        if (a_Elapsed + cost > a_Budget) {
+            return false;
+        }
+    }
+
+    *a_Tile = tile;
+    return true;
+}
+
+void FractalProgress::done (const Tile& a_Tile, double a_Time) {
+
+    double cost = a_Time / double(a_Tile.width * a_Tile.height);
+
+    // Follows changes of the view quickly as tiles of a field differ a lot
+    if (m_PixelCost == 0.0) {
+        m_PixelCost = cost;
+    } else {
+        m_PixelCost = 0.5 * m_PixelCost + 0.5 * cost;
+    }
+
+    m_Next++;
+}
@@ -0,0 +1,64 @@
+#ifndef FRACTAL_PROGRESSIVE_HH
+#define FRACTAL_PROGRESSIVE_HH
+
+#include <vector>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Time-sliced rendering of a fractal field. The field is split into tiles
+/// which are dispatched over as many frames as needed so that the time
+/// spent on the field stays within a budget per frame. Tiles go from the
+/// screen center outwards.
+///
+/// The cost of a tile is predicted from the measured cost per pixel of the
+/// tiles rendered so far. The first tile of a frame is always dispatched so
+/// that the field progresses however expensive it is.
+class FractalProgress
+{
+public:
+
+    /// Size of tiles in pixels
+    static constexpr size_t TILE_SIZE = 128;
+
+    /// A rectangle of the field
+    struct Tile {
+        size_t x      = 0;
+        size_t y      = 0;
+        size_t width  = 0;
+        size_t height = 0;
+    };
+
+    /// Starts a new field
+    void  start       (size_t a_Width, size_t a_Height);
+    /// Drops the field
+    void  reset       ();
+
+    /// A field is being rendered
+    bool  isActive    () const;
+    /// All tiles of the field were dispatched
+    bool  isDone      () const;
+    /// Returns the fraction of the field dispatched
+    float getProgress () const;
+
+    /// Returns the next tile if it fits the budget of the frame given the
+    /// time already spent in the frame
+    bool  next        (double a_Elapsed, double a_Budget, Tile* a_Tile) const;
+    /// Records the render time of the tile returned by next()
+    void  done        (const Tile& a_Tile, double a_Time);
+
+protected:
+
+    /// Tiles of the field in dispatch order
+    std::vector<Tile> m_Tiles;
+    /// Next tile to dispatch
+    size_t m_Next = 0;
+    /// A field is being rendered
+    bool   m_Active = false;
+
+    /// Estimated render time per pixel, kept between fields
+    double m_PixelCost = 0.0;
+};
+
+#endif // FRACTAL_PROGRESSIVE_HH
@@ -0,0 +1,103 @@
+#include "reference_orbit.hh"
+
+#include <algorithm>
+
+// ============================================================================
+
+void ReferenceOrbit::compute (FractalType a_Type,
+                              const std::array<BigFloat, 2>& a_Center,
+                              const std::array<double, 2>& a_Coeff,
+                              size_t a_MaxIter)
+{
+    m_Type    = a_Type;
+    m_Center  = a_Center;
+    m_Coeff   = a_Coeff;
+    m_MaxIter = a_MaxIter;
+    m_Escaped = false;
+
+    m_Orbit.clear();
+    m_Orbit.reserve(a_MaxIter + 1);
+
+    // Initialize. All the numbers get the precision of the center.
+    size_t bits = std::max(m_Center[0].getBits(), m_Center[1].getBits());
+    BigFloat zr, zi, cr, ci;
+
+    if (m_Type == FractalType::Mandelbrot) {
+        zr = BigFloat(0.0, bits);
+        zi = BigFloat(0.0, bits);
+        cr = m_Center[0];
+        ci = m_Center[1];
+    }
+    else {
+        zr = m_Center[0];
+        zi = m_Center[1];
+        cr = BigFloat(m_Coeff[0], bits);
+        ci = BigFloat(m_Coeff[1], bits);
+    }
+
+    zr.setBits(bits);
+    zi.setBits(bits);
+    cr.setBits(bits);
+    ci.setBits(bits);
+
+    BigFloat xx (0.0, bits);
+    BigFloat yy (0.0, bits);
+    BigFloat s  (0.0, bits);
+
+    // Iterate
+    for (size_t i=0; i<=a_MaxIter; ++i) {
+        double x = (double)zr;
+        double y = (double)zi;
+
+        m_Orbit.push_back(Complex(x, y));
+
+        if (x*x + y*y > ESCAPE_RADIUS2) {
+            m_Escaped = true;
+            break;
+        }
+
+        // Squaring takes half of the limb products of a multiplication so
+        // 2xy is computed as (x + y)^2 - x^2 - y^2
+        BigFloat::add(s, zr, zi);
+        BigFloat::sqr(xx, zr);
+        BigFloat::sqr(yy, zi);
+        BigFloat::sqr(s, s);
+
+        BigFloat::sub(zr, xx, yy);
+        BigFloat::add(zr, zr, cr);
+
+        BigFloat::sub(s, s, xx);
+        BigFloat::sub(s, s, yy);
+        BigFloat::add(zi, s, ci);
+    }
+}
+
+// ============================================================================
+
+FractalType ReferenceOrbit::getType () const {
+    return m_Type;
+}
+
+const std::array<BigFloat, 2>& ReferenceOrbit::getCenter () const {
+    return m_Center;
+}
+
+const std::array<double, 2>& ReferenceOrbit::getCoeff () const {
+    return m_Coeff;
+}
+
+size_t ReferenceOrbit::getMaxIter () const {
+    return m_MaxIter;
+}
+
+size_t ReferenceOrbit::getLength () const {
+    return m_Orbit.size();
+}
+
+bool ReferenceOrbit::hasEscaped () const {
+    return m_Escaped;
+}
+
+const std::vector<ReferenceOrbit::Complex>& ReferenceOrbit::getOrbit () const {
+    return m_Orbit;
+}
@@ -0,0 +1,71 @@
+#ifndef FRACTAL_REFERENCE_ORBIT_HH
+#define FRACTAL_REFERENCE_ORBIT_HH
+
+#include "fractal.hh"
+#include "big_float.hh"
+
+#include <vector>
+#include <array>
+#include <complex>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// A high precision orbit of a single reference point. Pixels in its
+/// vicinity iterate only their low precision difference from it
+/// (perturbation theory).
+class ReferenceOrbit
+{
+public:
+
+    /// Complex number type of the stored orbit
+    typedef std::complex<double> Complex;
+
+    /// Escape radius squared. Matches the one used by the shaders.
+    static constexpr double ESCAPE_RADIUS2 = 100.0;
+
+    /// Computes the orbit. For the Mandelbrot set the center is the "c"
+    /// parameter, for a Julia set it is the initial "z" and a_Coeff is the "c".
+    /// The orbit is computed with the precision of the center.
+    void compute (FractalType a_Type,
+                  const std::array<BigFloat, 2>& a_Center,
+                  const std::array<double, 2>& a_Coeff,
+                  size_t a_MaxIter);
+
+    /// Returns the fractal type
+    FractalType getType () const;
+    /// Returns the reference point
+    const std::array<BigFloat, 2>& getCenter () const;
+    /// Returns the Julia set coefficient
+    const std::array<double, 2>& getCoeff () const;
+    /// Returns the iteration limit the orbit was computed for
+    size_t getMaxIter () const;
+
+    /// Returns the orbit length. The last point is the escaped one if the
+    /// reference point escaped before the iteration limit.
+    size_t getLength () const;
+    /// Returns true if the reference point escaped
+    bool   hasEscaped () const;
+
+    /// Returns the orbit points
+    const std::vector<Complex>& getOrbit () const;
+
+protected:
+
+    /// Fractal type
+    FractalType m_Type = FractalType::Mandelbrot;
+    /// Reference point
+    std::array<BigFloat, 2> m_Center;
+    /// Julia set coefficient
+    std::array<double, 2>       m_Coeff = {{0.0, 0.0}};
+    /// Iteration limit
+    size_t m_MaxIter = 0;
+    /// Escaped flag
+    bool   m_Escaped = false;
+
+    /// The orbit rounded to double precision
+    std::vector<Complex> m_Orbit;
+};
+
+#endif // FRACTAL_REFERENCE_ORBIT_HH
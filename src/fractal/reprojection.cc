@@ -0,0 +1,95 @@
+#include "reprojection.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+bool FractalReprojection::View::isCompatible (const View& a_Other) const {
+    return valid    && a_Other.valid            &&
+           type     == a_Other.type             &&
+           (type == FractalType::Mandelbrot || coeff == a_Other.coeff) &&
+           exponent == a_Other.exponent         &&
+           maxIter  == a_Other.maxIter          &&
+           interior == a_Other.interior         &&
+           width    == a_Other.width            &&
+           height   == a_Other.height;
+}
+
+// ============================================================================
+
+float FractalReprojection::getMaxError () const {
+    return stationary ? 0.0f : MAX_ERROR;
+}
+
+FractalReprojection FractalReprojection::compute (const View& a_Prev, const View& a_Curr) {
+
+    FractalReprojection reproj;
+
+    // The iteration limit was raised over a field with a state
+    View prev = a_Prev;
+    bool raise = a_Prev.state && a_Curr.state && a_Prev.maxIter < a_Curr.maxIter;
+    if (raise) {
+        prev.maxIter = a_Curr.maxIter;
+    }
+
+    if (!prev.isCompatible(a_Curr)) {
+        return reproj;
+    }
+
+    // Screens map to the complex plane as p = R * uv / scale + position so
+    //  uv_prev = (s_prev / s_curr) * R(a_prev)^T * R(a_curr) * uv +
+    //            s_prev * R(a_prev)^T * (position_curr - position_prev)
+    const double k  = a_Prev.scale / a_Curr.scale;
+    const double da = a_Curr.rotation - a_Prev.rotation;
+    const double c  = cos(a_Prev.rotation);
+    const double s  = sin(a_Prev.rotation);
+    const double dx = (a_Curr.position[0] - a_Prev.position[0]) * a_Prev.scale;
+    const double dy = (a_Curr.position[1] - a_Prev.position[1]) * a_Prev.scale;
+
+    reproj.matrix = {{float(k * cos(da)), float(-k * sin(da)),
+                      float(k * sin(da)), float( k * cos(da))}};
+    reproj.offset = {{float( c * dx + s * dy),
+                      float(-s * dx + c * dy)}};
+
+    reproj.pixelScale = float(1.0 / k);
+
+    // Nothing of the previous screen is visible
+    const double aspect = double(a_Curr.width) / double(a_Curr.height);
+    const double radius = sqrt(1.0 + 1.0 / (aspect * aspect));
+    double distance = sqrt(dx * dx + dy * dy);
+
+    if (distance > radius * (1.0 + k)) {
+        return reproj;
+    }
+
+    // Zoomed in so much that previous samples are too sparse anyway
+    if (reproj.pixelScale > 1.0f + 2.0f * MAX_ERROR) {
+        return reproj;
+    }
+
+    // Largest displacement of screen corners in current pixels. Below the
+    // rounding noise threshold of the shaders the camera stands still.
+    double maxMove = 0.0;
+    for (double u : {-1.0, +1.0}) {
+        for (double v : {-1.0 / aspect, +1.0 / aspect}) {
+            double mu = reproj.matrix[0] * u + reproj.matrix[1] * v + reproj.offset[0];
+            double mv = reproj.matrix[2] * u + reproj.matrix[3] * v + reproj.offset[1];
+            double move = sqrt((mu - u) * (mu - u) + (mv - v) * (mv - v));
+
+            maxMove = std::max(maxMove, move * 0.5 * double(a_Curr.width) / k);
+        }
+    }
+
+    reproj.stationary = (maxMove < STATIONARY_MOVE);
+    reproj.enabled    = true;
+
+    // Samples are not comparable to the raised limit. The field is resumed
+    // if the camera stands still, recomputed otherwise.
+    if (raise) {
+        reproj.resume  = reproj.stationary;
+        reproj.enabled = false;
+    }
+
+    return reproj;
+}
@@ -0,0 +1,88 @@
+#ifndef FRACTAL_REPROJECTION_HH
+#define FRACTAL_REPROJECTION_HH
+
+#include "fractal.hh"
+
+#include <array>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Temporal reprojection of the iteration field. When only the view
+/// position, rotation or zoom changes, samples of the previous field remain
+/// valid and are moved by an affine map of screen (texture coordinate) space
+///
+///  uv_prev = matrix * uv + offset
+///
+/// A pixel reuses the nearest previous sample if the displacement of the
+/// sample, accumulated over all the frames it has been reused for, stays
+/// within a limit. The accumulated displacement is kept in an error field
+/// next to the iteration field. Newly exposed pixels and pixels whose
+/// samples drifted too far (e.g. when zooming in) are recomputed.
+///
+/// When only the iteration limit is raised the field is resumed instead.
+/// Pixels that hit the previous limit continue iterating from their orbit
+/// point saved in a state field, all the other pixels are kept.
+///
+/// The screen spans [-1, +1] horizontally and [-1/aspect, +1/aspect]
+/// vertically, the same as in the fractal shaders.
+struct FractalReprojection
+{
+    /// Parameters a field depends on
+    struct View {
+
+        /// The field exists
+        bool                  valid     = false;
+
+        FractalType           type      = FractalType::Mandelbrot;
+        std::array<double, 2> position  = {{0.0, 0.0}};
+        double                rotation  = 0.0;
+        double                scale     = 1.0;
+        /// Julia set coefficient, in any form
+        std::array<double, 2> coeff     = {{0.0, 0.0}};
+        /// Exponent of z^d + c
+        int                   exponent  = 2;
+        size_t                maxIter   = 0;
+        unsigned              interior  = 0;
+
+        size_t                width     = 0;
+        size_t                height    = 0;
+
+        /// The field has a state field to be resumed from
+        bool                  state     = false;
+
+        /// Returns true if the fields differ by the camera only
+        bool isCompatible (const View& a_Other) const;
+    };
+
+    /// Largest accumulated displacement of a reused sample in pixels
+    static constexpr float MAX_ERROR = 0.5f;
+    /// Camera movement in pixels under which samples do not drift. Shaders
+    /// ignore such displacements.
+    static constexpr double STATIONARY_MOVE = 1.0e-3;
+
+    /// Reprojection is possible
+    bool  enabled    = false;
+    /// The camera stands still. Only exact samples are reused so that the
+    /// field converges to an exact one.
+    bool  stationary = false;
+    /// The camera stands still and the iteration limit was raised. The
+    /// previous field is resumed.
+    bool  resume     = false;
+
+    /// Map from the current to the previous screen, row major
+    std::array<float, 4> matrix = {{1.0f, 0.0f, 0.0f, 1.0f}};
+    /// Offset of the map
+    std::array<float, 2> offset = {{0.0f, 0.0f}};
+    /// Size of a previous pixel in current pixels
+    float pixelScale = 1.0f;
+
+    /// Returns the displacement limit for the current frame
+    float getMaxError () const;
+
+    /// Computes the reprojection between two views
+    static FractalReprojection compute (const View& a_Prev, const View& a_Curr);
+};
+
+#endif // FRACTAL_REPROJECTION_HH
@@ -0,0 +1,63 @@
+#include "resolution_governor.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+
+double ResolutionGovernor::getScale () const {
+    return m_Scale;
+}
+
+bool ResolutionGovernor::reset () {
+
+    bool changed = (m_Scale != 1.0);
+
+    m_Scale = 1.0;
+    m_Raise = 0;
+
+    if (changed) {
+        m_Settle = SETTLE_FRAMES;
+    }
+
+    return changed;
+}
+
+bool ResolutionGovernor::update (double a_Time, double a_TargetTime) {
+
+    // The measurement may come from before the last change
+    if (m_Settle) {
+        m_Settle--;
+        return false;
+    }
+
+    double cost = a_Time / (m_Scale * m_Scale);
+    if (m_FullCost == 0.0) {
+        m_FullCost = cost;
+    } else {
+        m_FullCost = 0.75 * m_FullCost + 0.25 * cost;
+    }
+
+    // Largest scale that fits the budget
+    double scale = sqrt(BUDGET * a_TargetTime / std::max(m_FullCost, 1.0e-9));
+    scale = floor(scale / STEP) * STEP;
+    scale = std::max(double(MIN_SCALE), std::min(1.0, scale));
+
+    if (scale < m_Scale) {
+        m_Raise = 0;
+    }
+    else if (scale > m_Scale && ++m_Raise >= RAISE_FRAMES) {
+        scale   = m_Scale + STEP;
+        m_Raise = 0;
+    }
+    else {
+        if (scale == m_Scale) {
+            m_Raise = 0;
+        }
+        return false;
+    }
+
+    m_Scale  = scale;
+    m_Settle = SETTLE_FRAMES;
+    return true;
+}
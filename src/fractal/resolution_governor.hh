@@ -0,0 +1,54 @@
+#ifndef FRACTAL_RESOLUTION_GOVERNOR_HH
+#define FRACTAL_RESOLUTION_GOVERNOR_HH
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Controls the resolution of the fractal field relative to the screen so
+/// that the fractal pass fits a share of the target frame time while the
+/// view moves. The cost of the field at full resolution is estimated from
+/// measured pass times assuming that it goes with the pixel count. Once the
+/// view stops the owner resets it to the full resolution.
+///
+/// The scale drops as soon as the pass is too slow and rises one step at a
+/// time after a number of frames asking for it. Every change reallocates the
+/// field and invalidates reprojection, measurements made before a change
+/// are still in flight for a few frames after it and are ignored.
+class ResolutionGovernor
+{
+public:
+
+    /// Smallest scale
+    static constexpr double MIN_SCALE    = 0.25;
+    /// Scale step
+    static constexpr double STEP         = 0.125;
+    /// Share of the target frame time for the fractal pass
+    static constexpr double BUDGET       = 0.6;
+    /// Frames asking for a higher scale before it is raised
+    static constexpr size_t RAISE_FRAMES = 8;
+    /// Frames ignored after a change
+    static constexpr size_t SETTLE_FRAMES = 4;
+
+    /// Returns the current scale
+    double getScale () const;
+
+    /// Updates the scale with a pass time measured while the view moves.
+    /// Returns true if the scale changed.
+    bool   update   (double a_Time, double a_TargetTime);
+    /// Returns to the full resolution. Returns true if the scale changed.
+    bool   reset    ();
+
+protected:
+
+    /// Current scale
+    double m_Scale    = 1.0;
+    /// Estimated pass time at full resolution
+    double m_FullCost = 0.0;
+    /// Frames asking for a higher scale
+    size_t m_Raise    = 0;
+    /// Frames left to ignore
+    size_t m_Settle   = 0;
+};
+
+#endif // FRACTAL_RESOLUTION_GOVERNOR_HH
@@ -0,0 +1,177 @@
+#include "series_approx.hh"
+
+#include <algorithm>
+
+// ============================================================================
+
+void SeriesApprox::compute (const ReferenceOrbit& a_Orbit,
+                            const std::vector<ComplexExp>& a_Probes,
+                            const FloatExp& a_Radius,
+                            size_t a_Terms,
+                            size_t a_MaxSkip)
+{
+    const auto& orbit = a_Orbit.getOrbit();
+    size_t terms = std::min(a_Terms, MAX_TERMS);
+
+    m_Skip   = 0;
+    m_Radius = a_Radius;
+    m_Coeffs.clear();
+
+    if (terms == 0 || orbit.size() < 3 || !(FloatExp(0.0) < a_Radius)) {
+        return;
+    }
+
+    // Probe offsets divided by the radius, they are in doubles range
+    std::vector<Complex> units (a_Probes.size());
+    for (size_t i=0; i<a_Probes.size(); ++i) {
+        units[i] = Complex(a_Probes[i] / a_Radius);
+    }
+
+    // Leave at least one reference point for the pixel loop
+    size_t maxSkip = std::min(a_MaxSkip, orbit.size() - 2);
+
+    // Doubles as long as squared offsets do not underflow, floatexp beyond
+    if (FloatExp(MIN_DOUBLE_RADIUS) <= a_Radius) {
+        std::vector<Complex> probes (a_Probes.size());
+        for (size_t i=0; i<a_Probes.size(); ++i) {
+            probes[i] = Complex(a_Probes[i]);
+        }
+
+        std::vector<Complex> coeffs (terms, Complex(0.0, 0.0));
+        m_Skip = iterate(a_Orbit, probes, units, Complex(double(a_Radius), 0.0),
+                         maxSkip, &coeffs);
+
+        for (const auto& coeff : coeffs) {
+            m_Coeffs.push_back(ComplexExp(coeff));
+        }
+    }
+    else {
+        m_Coeffs.assign(terms, ComplexExp());
+        m_Skip = iterate(a_Orbit, a_Probes, units, ComplexExp(a_Radius),
+                         maxSkip, &m_Coeffs);
+    }
+}
+
+// ============================================================================
+
+/// Sum of products a[i] * b[n-1-i] in doubles, the floatexp one is in
+/// float_exp.hh
+static inline SeriesApprox::Complex convolve (const SeriesApprox::Complex* a,
+                                              const SeriesApprox::Complex* b,
+                                              size_t n)
+{
+    SeriesApprox::Complex sum (0.0, 0.0);
+    for (size_t i=0; i<n; ++i) {
+        sum += a[i] * b[n - 1 - i];
+    }
+    return sum;
+}
+
+// ============================================================================
+
+template <typename T>
+size_t SeriesApprox::iterate (const ReferenceOrbit& a_Orbit,
+                              const std::vector<T>& a_Probes,
+                              const std::vector<Complex>& a_Units,
+                              const T& a_Radius,
+                              size_t a_MaxSkip,
+                              std::vector<T>* a_Coeffs)
+{
+    const auto& orbit = a_Orbit.getOrbit();
+    bool isJulia = (a_Orbit.getType() == FractalType::Julia);
+
+    std::vector<T>& current = *a_Coeffs;
+
+    // Initial offsets. For the Mandelbrot set the "z" starts at zero for
+    // all pixels, for a Julia set the offset itself is the "z".
+    std::vector<T> probes (a_Probes.size());
+    for (size_t i=0; i<a_Probes.size(); ++i) {
+        probes[i] = isJulia ? a_Probes[i] : T();
+    }
+
+    if (isJulia) {
+        current[0] = a_Radius;
+    }
+
+    // Iterate
+    std::vector<T> coeffs (current.size());
+    size_t skip = 0;
+
+    for (size_t n=0; n<a_MaxSkip; ++n) {
+        Complex Z2 = 2.0 * orbit[n];
+
+        // Advance the series
+        for (size_t k=0; k<coeffs.size(); ++k) {
+
+            // Coefficient products of the squared term. Index k is of the
+            // term of power k+1.
+            coeffs[k] = Z2 * current[k] + convolve(current.data(), current.data(), k);
+        }
+
+        if (!isJulia) {
+            coeffs[0] += a_Radius;
+        }
+
+        // Advance the probes and compare
+        bool valid = true;
+        for (size_t i=0; i<probes.size() && valid; ++i) {
+            T& dz = probes[i];
+            dz = (Z2 + dz) * dz + (isJulia ? T() : a_Probes[i]);
+
+            // The probe escaped or would get rebased
+            Complex z = orbit[n + 1] + Complex(dz);
+            if (std::norm(z) > ReferenceOrbit::ESCAPE_RADIUS2 ||
+                std::norm(z) < norm(dz))
+            {
+                valid = false;
+                break;
+            }
+
+            T err = evaluate(coeffs, a_Units[i]) - dz;
+            if (!(norm(err) <= TOLERANCE * TOLERANCE * norm(dz))) {
+                valid = false;
+            }
+        }
+
+        if (!valid) {
+            break;
+        }
+
+        current = coeffs;
+        skip    = n + 1;
+    }
+
+    return skip;
+}
+
+// ============================================================================
+
+template <typename T>
+T SeriesApprox::evaluate (const std::vector<T>& a_Coeffs, const Complex& a_U) {
+
+    // Horner's scheme, there is no constant term
+    T sum = T();
+    for (size_t k=a_Coeffs.size(); k>0; --k) {
+        sum = (sum + a_Coeffs[k - 1]) * a_U;
+    }
+
+    return sum;
+}
+
+ComplexExp SeriesApprox::evaluate (const Complex& a_U) const {
+    return evaluate(m_Coeffs, a_U);
+}
+
+// ============================================================================
+
+size_t SeriesApprox::getSkip () const {
+    return m_Skip;
+}
+
+const FloatExp& SeriesApprox::getRadius () const {
+    return m_Radius;
+}
+
+const std::vector<ComplexExp>& SeriesApprox::getCoeffs () const {
+    return m_Coeffs;
+}
@@ -0,0 +1,86 @@
+#ifndef FRACTAL_SERIES_APPROX_HH
+#define FRACTAL_SERIES_APPROX_HH
+
+#include "reference_orbit.hh"
+#include "float_exp.hh"
+
+#include <vector>
+#include <complex>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Series approximation of the pixel orbits around a reference orbit. While
+/// all pixels of a view still follow the reference their differences from
+/// it are well described by a truncated polynomial in the pixel offset.
+/// Pixels may then start iterating at the last iteration where it holds.
+///
+/// Coefficients are stored scaled by powers of the view radius so that the
+/// polynomial is evaluated for offsets in the unit circle. Offsets and
+/// coefficients are in floatexp as they get out of the double range at
+/// deep zooms. The computation itself is done in doubles as long as the
+/// squared view radius fits them and switches to floatexp beyond.
+class SeriesApprox
+{
+public:
+
+    /// Complex number type
+    typedef std::complex<double> Complex;
+
+    /// Maximum number of terms
+    static constexpr size_t MAX_TERMS = 16;
+
+    /// Allowed error of the approximation relative to the exact offset
+    /// of a probe point
+    static constexpr double TOLERANCE = 1.0e-5;
+
+    /// Smallest view radius the approximation is computed for in doubles
+    static constexpr double MIN_DOUBLE_RADIUS = 1.0e-140;
+
+    /// Computes the approximation for the given reference orbit. Probe
+    /// points are offsets from the reference point on the complex plane
+    /// spanning the view, a_Radius is the largest offset to be approximated.
+    void compute (const ReferenceOrbit& a_Orbit,
+                  const std::vector<ComplexExp>& a_Probes,
+                  const FloatExp& a_Radius,
+                  size_t a_Terms,
+                  size_t a_MaxSkip);
+
+    /// Returns the number of iterations that can be skipped
+    size_t getSkip () const;
+    /// Returns the view radius the coefficients are scaled by
+    const FloatExp& getRadius () const;
+    /// Returns the scaled coefficients, the first one is of the linear term
+    const std::vector<ComplexExp>& getCoeffs () const;
+
+    /// Evaluates the approximation for an offset divided by the radius
+    ComplexExp evaluate (const Complex& a_U) const;
+
+protected:
+
+    /// Iterates the series and the probes with offsets of type T, either
+    /// Complex or ComplexExp. Returns the number of iterations that can be
+    /// skipped and their coefficients.
+    template <typename T>
+    static size_t iterate (const ReferenceOrbit& a_Orbit,
+                           const std::vector<T>& a_Probes,
+                           const std::vector<Complex>& a_Units,
+                           const T& a_Radius,
+                           size_t a_MaxSkip,
+                           std::vector<T>* a_Coeffs);
+
+    /// Evaluates a polynomial for an offset divided by the radius
+    template <typename T>
+    static T evaluate (const std::vector<T>& a_Coeffs,
+                       const Complex& a_U);
+
+    /// Iterations that can be skipped
+    size_t m_Skip = 0;
+    /// View radius
+    FloatExp m_Radius = 1.0;
+    /// Scaled coefficients
+    std::vector<ComplexExp> m_Coeffs;
+};
+
+#endif // FRACTAL_SERIES_APPROX_HH
@@ -0,0 +1,78 @@
+#include "symmetry.hh"
+
+#include <cmath>
+
+// ============================================================================
+
+FractalSymmetry FractalSymmetry::compute (FractalType a_Type,
+                                          const std::array<double, 2>& a_Position,
+                                          double a_Rotation,
+                                          double a_Scale,
+                                          size_t a_Width,
+                                          size_t a_Height)
+{
+    FractalSymmetry symmetry;
+
+    // The screen maps to the complex plane as p = R * uv / scale + position
+    const double c  = cos(a_Rotation);
+    const double s  = sin(a_Rotation);
+    const double px = a_Position[0] * a_Scale;
+    const double py = a_Position[1] * a_Scale;
+
+    // Mandelbrot: p' = conj(p)
+    if (a_Type == FractalType::Mandelbrot) {
+        const double c2 = cos(2.0 * a_Rotation);
+        const double s2 = sin(2.0 * a_Rotation);
+
+        symmetry.mirror = {{float( c2), float(-s2), float(-s2), float(-c2)}};
+        symmetry.offset = {{float(-2.0 * py * s), float(-2.0 * py * c)}};
+    }
+
+    // Julia: p' = -p
+    else {
+        symmetry.mirror = {{-1.0f, 0.0f, 0.0f, -1.0f}};
+        symmetry.offset = {{float(-2.0 * ( c * px + s * py)),
+                            float(-2.0 * (-s * px + c * py))}};
+    }
+
+    // Redundant are pixels with negative imaginary part, further than 1.5
+    // pixel from the axis
+    const double margin = 1.5 * 2.0 / double(a_Width);
+    symmetry.half = {{float(s), float(c), float(py + margin)}};
+
+    // Estimate the redundant fraction of the screen
+    const size_t GRID   = 32;
+    const float  aspect = float(a_Width) / float(a_Height);
+
+    size_t count = 0;
+    for (size_t y=0; y<GRID; ++y) {
+        for (size_t x=0; x<GRID; ++x) {
+            float u = -1.0f + 2.0f * (float(x) + 0.5f) / float(GRID);
+            float v = (-1.0f + 2.0f * (float(y) + 0.5f) / float(GRID)) / aspect;
+
+            float mu, mv;
+            if (symmetry.isRedundant(u, v, &mu, &mv, aspect)) {
+                count++;
+            }
+        }
+    }
+
+    symmetry.redundant = float(count) / float(GRID * GRID);
+    symmetry.enabled   = symmetry.redundant >= MIN_REDUNDANT;
+
+    return symmetry;
+}
+
+bool FractalSymmetry::isRedundant (float a_U, float a_V,
+                                   float* a_MirrorU, float* a_MirrorV,
+                                   float a_Aspect) const
+{
+    if (half[0] * a_U + half[1] * a_V + half[2] >= 0.0f) {
+        return false;
+    }
+
+    *a_MirrorU = mirror[0] * a_U + mirror[1] * a_V + offset[0];
+    *a_MirrorV = mirror[2] * a_U + mirror[3] * a_V + offset[1];
+
+    return fabsf(*a_MirrorU) <= 1.0f && fabsf(*a_MirrorV) <= 1.0f / a_Aspect;
+}
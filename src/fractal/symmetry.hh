@@ -0,0 +1,56 @@
+#ifndef FRACTAL_SYMMETRY_HH
+#define FRACTAL_SYMMETRY_HH
+
+#include "fractal.hh"
+
+#include <array>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Symmetry of a fractal view in screen (texture coordinate) space. The
+/// Mandelbrot set is symmetric about the real axis, quadratic Julia sets
+/// under z -> -z. Either maps the screen onto itself by an isometry
+///
+///  uv' = mirror * uv + offset
+///
+/// Pixels on the negative side of the half-plane (half.xy, half.z) whose
+/// mirror images land on screen are redundant. They are copied from their
+/// images instead of being computed. The half-plane is moved by a margin
+/// so that the nearest pixel of an image is always a computed one.
+///
+/// The screen spans [-1, +1] horizontally and [-1/aspect, +1/aspect]
+/// vertically, the same as in the fractal shaders.
+struct FractalSymmetry
+{
+    /// Fraction of redundant pixels under which symmetry is not worth the
+    /// extra copy pass
+    static constexpr double MIN_REDUNDANT = 0.05;
+
+    /// Symmetry is worth using for the view
+    bool  enabled = false;
+    /// Estimated fraction of redundant pixels
+    float redundant = 0.0f;
+
+    /// Mirror matrix, row major
+    std::array<float, 4> mirror = {{1.0f, 0.0f, 0.0f, 1.0f}};
+    /// Mirror offset
+    std::array<float, 2> offset = {{0.0f, 0.0f}};
+    /// Half-plane of redundant pixels, dot(half.xy, uv) + half.z < 0
+    std::array<float, 3> half   = {{0.0f, 0.0f, 0.0f}};
+
+    /// Computes the symmetry of a view
+    static FractalSymmetry compute (FractalType a_Type,
+                                    const std::array<double, 2>& a_Position,
+                                    double a_Rotation,
+                                    double a_Scale,
+                                    size_t a_Width,
+                                    size_t a_Height);
+
+    /// Returns true if a point is redundant, the mirror image is returned
+    bool isRedundant (float a_U, float a_V, float* a_MirrorU, float* a_MirrorV,
+                      float a_Aspect) const;
+};
+
+#endif // FRACTAL_SYMMETRY_HH
@@ -0,0 +1,537 @@
+#include "tile_cache.hh"
+
+#include <algorithm>
+#include <fstream>
+
+#include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// ============================================================================
+
+/// Floor division, rounds towards minus infinity
+static int64_t floorDiv (int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+/// Splits the grid coordinate (a_Value + ROOT_SIZE/2) / size of a level
+/// into the column and the fraction within it. Exact where doubles would
+/// not resolve the column.
+static void getGridCoord (const Fixed128& a_Value, int a_Level,
+                          int64_t* a_Column, double* a_Fraction)
+{
+    // The value is in [0, 8) for views within the grid. The grid
+    // coordinate is its fixed-point representation shifted right by
+    // 127 - level bits, all of them below the high limb as the level is at
+    // most 63.
+    Fixed128 g = a_Value + Fixed128(0.5 * TileCache::ROOT_SIZE);
+    int      s = 63 - a_Level;
+    uint64_t m = (uint64_t(1) << s) - 1;
+
+    *a_Column   = int64_t(g.hi) >> s;
+    *a_Fraction = ldexp(double(g.hi & m), -s) + ldexp(double(g.lo), -s - 64);
+}
+
+/// Returns the center of a tile in fixed point, exact
+static Fixed128 getTileCenter (int64_t a_Column, int a_Level) {
+
+    // Both parts of the column are exact in doubles and so are their
+    // products with the tile size
+    const double size = ldexp(TileCache::ROOT_SIZE, -a_Level);
+    const double hi   = double(a_Column >> 32) * 4294967296.0;
+    const double lo   = double(a_Column & 0xFFFFFFFF) + 0.5;
+
+    return Fixed128(hi * size) + Fixed128(lo * size) - Fixed128(0.5 * TileCache::ROOT_SIZE);
+}
+
+TileCache::Key TileCache::Key::getParent () const {
+    Key parent;
+    parent.level = level - 1;
+    parent.x     = floorDiv(x, 2);
+    parent.y     = floorDiv(y, 2);
+    return parent;
+}
+
+size_t TileCache::KeyHash::operator () (const Key& a_Key) const {
+    uint64_t h = uint64_t(a_Key.level);
+    h = h * 0x9E3779B97F4A7C15ull + uint64_t(a_Key.x);
+    h = h * 0x9E3779B97F4A7C15ull + uint64_t(a_Key.y);
+    return size_t(h ^ (h >> 32));
+}
+
+bool TileCache::Params::operator == (const Params& a_Other) const {
+    return type     == a_Other.type     &&
+           coeff[0] == a_Other.coeff[0] &&
+           coeff[1] == a_Other.coeff[1] &&
+           maxIter  == a_Other.maxIter  &&
+           interior == a_Other.interior;
+}
+
+// ============================================================================
+
+TileCache::TileCache (size_t a_Budget, const std::string& a_SpillDir, CpuIsa a_Isa, size_t a_Threads) :
+    m_SpillDir     (a_SpillDir),
+    m_FloatKernel  (getCpuKernel(a_Isa, false)),
+    m_DoubleKernel (getCpuKernel(a_Isa, true))
+{
+    const size_t tileBytes = TILE_SIZE * TILE_SIZE * sizeof(float);
+    m_MaxTiles = std::max(size_t(1), a_Budget / tileBytes);
+
+    // Spilling is disabled if the directory can't be made
+    if (!m_SpillDir.empty()) {
+#ifdef _WIN32
+        _mkdir(m_SpillDir.c_str());
+#else
+        mkdir(m_SpillDir.c_str(), 0755);
+#endif
+        std::ofstream probe (getProbeFileName(), std::ios::binary);
+        if (!probe.good()) {
+            m_SpillDir.clear();
+        }
+    }
+
+    // Leave the rest of the CPU to the application
+    if (a_Threads == 0) {
+        a_Threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+
+    for (size_t i=0; i<a_Threads; ++i) {
+        m_Workers.push_back(std::thread(&TileCache::workerProc, this));
+    }
+}
+
+TileCache::~TileCache () {
+
+    {
+        std::lock_guard<std::mutex> lock (m_Mutex);
+        m_Stop = true;
+    }
+
+    m_Signal.notify_all();
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock (m_Mutex);
+    clearDisk();
+
+    if (!m_SpillDir.empty()) {
+        std::remove(getProbeFileName().c_str());
+    }
+}
+
+// ============================================================================
+
+void TileCache::setParams (const Params& a_Params) {
+
+    std::lock_guard<std::mutex> lock (m_Mutex);
+
+    if (a_Params == m_Params) {
+        return;
+    }
+
+    // Tiles in progress are dropped when done as their generation is stale
+    m_Tiles.clear();
+    m_Lru.clear();
+    m_Queue.clear();
+    m_Pending.clear();
+    clearDisk();
+
+    m_Params = a_Params;
+    m_Generation++;
+}
+
+int TileCache::getLevel (const CpuKernelArgs& a_View) {
+
+    // Texels must not be larger than pixels
+    const double size = ROOT_SIZE * double(a_View.width) * a_View.scale / (2.0 * double(TILE_SIZE));
+    return std::max(0, int(ceil(log2(size))));
+}
+
+bool TileCache::isCachable (const CpuKernelArgs& a_View) {
+    return getLevel(a_View) <= MAX_LEVEL;
+}
+
+// ============================================================================
+
+void TileCache::composite (const CpuKernelArgs& a_View, float* a_Field) {
+
+    const int    level  = std::min(getLevel(a_View), int(MAX_LEVEL));
+    const double size   = ROOT_SIZE / pow(2.0, level);
+    const double half   = 0.5 * ROOT_SIZE;
+    const size_t width  = a_View.width;
+    const size_t height = a_View.height;
+    const float  aspect = float(width) / float(height);
+
+    // Grid coordinates are kept relative to the column and row of the view
+    // center, they are small and doubles resolve them at any level
+    int64_t bx, by;
+    double  fx, fy;
+
+    if (level <= DOUBLE_LEVELS) {
+        const double gx = (a_View.position[0] + half) / size;
+        const double gy = (a_View.position[1] + half) / size;
+        bx = int64_t(floor(gx));
+        by = int64_t(floor(gy));
+        fx = gx - double(bx);
+        fy = gy - double(by);
+    }
+    else {
+        getGridCoord(a_View.center[0], level, &bx, &fx);
+        getGridCoord(a_View.center[1], level, &by, &fy);
+    }
+
+    // Same mapping as the kernels (see CpuKernelMapping)
+    const float  rotation = float(a_View.rotation);
+    const double c = cosf(rotation);
+    const double s = sinf(rotation);
+
+    auto map = [&](float u, float v, double* gx, double* gy) {
+        *gx = fx + (c * u - s * v) / a_View.scale / size;
+        *gy = fy + (s * u + c * v) / a_View.scale / size;
+    };
+
+    // Tiles covering the screen
+    double gx0 = HUGE_VAL, gy0 = HUGE_VAL, gx1 = -HUGE_VAL, gy1 = -HUGE_VAL;
+    for (float u : {-1.0f, 1.0f}) {
+        for (float v : {-1.0f / aspect, 1.0f / aspect}) {
+            double gx, gy;
+            map(u, v, &gx, &gy);
+
+            gx0 = std::min(gx0, gx); gx1 = std::max(gx1, gx);
+            gy0 = std::min(gy0, gy); gy1 = std::max(gy1, gy);
+        }
+    }
+
+    // Both relative to the column and row of the view center
+    const int64_t tx0 = int64_t(floor(gx0));
+    const int64_t ty0 = int64_t(floor(gy0));
+    const int64_t cols = int64_t(floor(gx1)) - tx0 + 1;
+    const int64_t rows = int64_t(floor(gy1)) - ty0 + 1;
+
+    // A tile of the grid, or the nearest cached ancestor of it
+    struct Slot {
+        std::shared_ptr<const Tile> tile;
+        int depth = 0;
+    };
+
+    std::vector<Slot> grid (size_t(cols * rows));
+    std::vector<Key>  missing;
+
+    {
+        std::lock_guard<std::mutex> lock (m_Mutex);
+
+        // Tiles requested for previous views may not be needed any more
+        for (const Key& key : m_Queue) {
+            m_Pending.erase(key);
+        }
+        m_Queue.clear();
+
+        for (int64_t j=0; j<rows; ++j) {
+            for (int64_t i=0; i<cols; ++i) {
+                Slot& slot = grid[size_t(j * cols + i)];
+
+                Key key;
+                key.level = level;
+                key.x     = bx + tx0 + i;
+                key.y     = by + ty0 + j;
+
+                slot.tile = find(key);
+                if (slot.tile) {
+                    continue;
+                }
+
+                if (!m_Pending.count(key)) {
+                    missing.push_back(key);
+                }
+
+                while (!slot.tile && key.level > 0) {
+                    key = key.getParent();
+                    slot.depth++;
+                    slot.tile = find(key);
+                }
+            }
+        }
+
+        // The screen center first
+        const double cx = 0.5 * (gx0 + gx1);
+        const double cy = 0.5 * (gy0 + gy1);
+
+        auto distance = [&](const Key& k) {
+            double dx = double(k.x - bx) + 0.5 - cx;
+            double dy = double(k.y - by) + 0.5 - cy;
+            return dx * dx + dy * dy;
+        };
+
+        std::stable_sort(missing.begin(), missing.end(),
+            [&](const Key& a, const Key& b) {
+                return distance(a) < distance(b);
+            });
+
+        for (const Key& key : missing) {
+            m_Queue.push_back(key);
+            m_Pending.insert(key);
+        }
+    }
+
+    if (!missing.empty()) {
+        m_Signal.notify_all();
+    }
+
+    // Sample the nearest texels
+    size_t hits = 0;
+
+    for (size_t y=0; y<height; ++y) {
+        const float v = (-1.0f + 2.0f * (float(y) + 0.5f) / float(height)) / aspect;
+
+        for (size_t x=0; x<width; ++x) {
+            const float u = -1.0f + 2.0f * (float(x) + 0.5f) / float(width);
+
+            double gx, gy;
+            map(u, v, &gx, &gy);
+
+            int64_t i = std::min(std::max(int64_t(floor(gx)) - tx0, int64_t(0)), cols - 1);
+            int64_t j = std::min(std::max(int64_t(floor(gy)) - ty0, int64_t(0)), rows - 1);
+
+            const Slot& slot = grid[size_t(j * cols + i)];
+            if (!slot.tile) {
+                a_Field[y * width + x] = 0.0f;
+                continue;
+            }
+
+            // Coordinates within the ancestor. The position of the tile
+            // within it comes from the low bits of the absolute column and
+            // row.
+            const int64_t mask = (int64_t(1) << slot.depth) - 1;
+            const int64_t tx   = int64_t(floor(gx));
+            const int64_t ty   = int64_t(floor(gy));
+            const double  k    = ldexp(1.0, -slot.depth);
+
+            gx = (double((bx + tx) & mask) + (gx - double(tx))) * k;
+            gy = (double((by + ty) & mask) + (gy - double(ty))) * k;
+
+            const int tiles = int(TILE_SIZE);
+
+            int ix = std::min(int(gx * double(tiles)), tiles - 1);
+            int iy = std::min(int(gy * double(tiles)), tiles - 1);
+
+            a_Field[y * width + x] = (*slot.tile)[size_t(iy) * TILE_SIZE + size_t(ix)];
+            if (slot.depth == 0) {
+                hits++;
+            }
+        }
+    }
+
+    const size_t pixels = width * height;
+
+    std::lock_guard<std::mutex> lock (m_Mutex);
+    m_HitRate = pixels ? double(hits) / double(pixels) : 0.0;
+}
+
+TileCache::Stats TileCache::getStats () const {
+
+    std::lock_guard<std::mutex> lock (m_Mutex);
+
+    Stats stats;
+    stats.memory  = m_Tiles.size();
+    stats.disk    = m_OnDisk.size();
+    stats.pending = m_Pending.size();
+    stats.hitRate = m_HitRate;
+
+    return stats;
+}
+
+// ============================================================================
+
+std::shared_ptr<const TileCache::Tile> TileCache::find (const Key& a_Key) {
+
+    auto it = m_Tiles.find(a_Key);
+    if (it == m_Tiles.end()) {
+        return nullptr;
+    }
+
+    m_Lru.splice(m_Lru.begin(), m_Lru, it->second.lru);
+    return it->second.tile;
+}
+
+void TileCache::insert (const Key& a_Key, std::shared_ptr<const Tile> a_Tile,
+                        std::vector<std::pair<Key, std::shared_ptr<const Tile>>>* a_Evicted)
+{
+    if (m_Tiles.count(a_Key)) {
+        return;
+    }
+
+    m_Lru.push_front(a_Key);
+
+    Entry entry;
+    entry.tile = a_Tile;
+    entry.lru  = m_Lru.begin();
+    m_Tiles[a_Key] = entry;
+
+    while (m_Tiles.size() > m_MaxTiles) {
+        const Key key = m_Lru.back();
+
+        // Tiles loaded from disk are still there. A tile already being
+        // spilled by another worker is the same, it is left to it.
+        if (!m_SpillDir.empty() && !m_OnDisk.count(key) && !m_Spilling.count(key)) {
+            a_Evicted->push_back(std::make_pair(key, m_Tiles.at(key).tile));
+            m_Spilling.insert(key);
+        }
+
+        m_Tiles.erase(key);
+        m_Lru.pop_back();
+    }
+}
+
+// ============================================================================
+
+void TileCache::compute (const Key& a_Key, const Params& a_Params, Tile* a_Tile) const {
+
+    const double size = ROOT_SIZE / pow(2.0, a_Key.level);
+    const double half = 0.5 * ROOT_SIZE;
+
+    // The tile is a square view
+    CpuKernelArgs args;
+    args.type        = a_Params.type;
+    args.position[0] = (double(a_Key.x) + 0.5) * size - half;
+    args.position[1] = (double(a_Key.y) + 0.5) * size - half;
+    args.rotation    = 0.0;
+    args.scale       = 2.0 / size;
+    args.coeff[0]    = a_Params.coeff[0];
+    args.coeff[1]    = a_Params.coeff[1];
+    args.maxIter     = a_Params.maxIter;
+    args.interior    = a_Params.interior;
+    args.epsilon     = 1.0e-3 * size / double(TILE_SIZE);
+    args.width       = TILE_SIZE;
+    args.height      = TILE_SIZE;
+
+    a_Tile->resize(TILE_SIZE * TILE_SIZE);
+
+    // Deep tiles in fixed point from their exact center
+    if (a_Key.level > DOUBLE_LEVELS) {
+        args.center[0] = getTileCenter(a_Key.x, a_Key.level);
+        args.center[1] = getTileCenter(a_Key.y, a_Key.level);
+        cpuKernelFixed128(args, 0, 0, TILE_SIZE, TILE_SIZE, a_Tile->data(), nullptr);
+        return;
+    }
+
+    CpuKernel kernel = (a_Key.level < FLOAT_LEVELS) ? m_FloatKernel : m_DoubleKernel;
+    kernel(args, 0, 0, TILE_SIZE, TILE_SIZE, a_Tile->data(), nullptr);
+}
+
+std::string TileCache::getFileName (const Key& a_Key) const {
+    return m_SpillDir + "/" +
+           std::to_string(a_Key.level) + "_" +
+           std::to_string(a_Key.x) + "_" +
+           std::to_string(a_Key.y) + ".tile";
+}
+
+std::string TileCache::getProbeFileName () const {
+    return m_SpillDir + "/.probe";
+}
+
+bool TileCache::load (const Key& a_Key, Tile* a_Tile) const {
+
+    std::ifstream file (getFileName(a_Key), std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+
+    a_Tile->resize(TILE_SIZE * TILE_SIZE);
+    file.read((char*)a_Tile->data(), a_Tile->size() * sizeof(float));
+
+    return size_t(file.gcount()) == a_Tile->size() * sizeof(float);
+}
+
+bool TileCache::save (const Key& a_Key, const Tile& a_Tile) const {
+
+    std::ofstream file (getFileName(a_Key), std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+
+    file.write((const char*)a_Tile.data(), a_Tile.size() * sizeof(float));
+    return file.good();
+}
+
+void TileCache::clearDisk () {
+
+    for (const Key& key : m_OnDisk) {
+        std::remove(getFileName(key).c_str());
+    }
+
+    m_OnDisk.clear();
+}
+
+// ============================================================================
+
+void TileCache::workerProc () {
+
+    std::unique_lock<std::mutex> lock (m_Mutex);
+
+    while (true) {
+        m_Signal.wait(lock, [&]{ return m_Stop || !m_Queue.empty(); });
+        if (m_Stop) {
+            break;
+        }
+
+        const Key      key        = m_Queue.front();
+        const Params   params     = m_Params;
+        const uint64_t generation = m_Generation;
+        const bool     onDisk     = m_OnDisk.count(key) != 0;
+        m_Queue.pop_front();
+
+        // Load or compute without the lock
+        lock.unlock();
+
+        auto tile = std::make_shared<Tile>();
+        if (!onDisk || !load(key, tile.get())) {
+            compute(key, params, tile.get());
+        }
+
+        lock.lock();
+
+        // The parameters changed meanwhile
+        if (generation != m_Generation) {
+            continue;
+        }
+
+        std::vector<std::pair<Key, std::shared_ptr<const Tile>>> evicted;
+        m_Pending.erase(key);
+        insert(key, tile, &evicted);
+
+        if (evicted.empty()) {
+            continue;
+        }
+
+        // Spill without the lock
+        lock.unlock();
+
+        std::vector<Key> saved;
+        for (const auto& item : evicted) {
+            if (save(item.first, *item.second)) {
+                saved.push_back(item.first);
+            }
+        }
+
+        lock.lock();
+
+        for (const auto& item : evicted) {
+            m_Spilling.erase(item.first);
+        }
+
+        if (generation == m_Generation) {
+            m_OnDisk.insert(saved.begin(), saved.end());
+        } else {
+            for (const Key& k : saved) {
+                std::remove(getFileName(k).c_str());
+            }
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#ifndef FRACTAL_TILE_CACHE_HH
+#define FRACTAL_TILE_CACHE_HH
+
+#include "cpu_kernel.hh"
+
+#include <vector>
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+
+/// Cache of smooth iteration count tiles aligned to a quadtree over the
+/// complex plane, like map tiles. Level 0 tiles span ROOT_SIZE, the tile
+/// (0, 0) being centered at the origin, each level halves the tile size. A
+/// tile is identified by its level and its column and row within the level.
+/// Tiles deeper than doubles resolve are computed in fixed point, views are
+/// then located by their fixed-point center.
+///
+/// Views are composited from cached tiles of the level whose texels are
+/// not larger than the screen pixels. Missing tiles are computed in the
+/// background by worker threads with the CPU kernels and are substituted
+/// by cached tiles of coarser levels meanwhile. Tiles are kept within a
+/// memory budget, the least recently used ones are evicted. Evicted tiles
+/// can be spilled to a directory and are loaded back instead of being
+/// computed again.
+///
+/// The tiles depend on the fractal parameters (see Params). Changing them
+/// drops all the tiles.
+class TileCache
+{
+public:
+
+    /// Tile size in texels
+    static constexpr size_t TILE_SIZE  = 256;
+    /// Level 0 tile size on the complex plane
+    static constexpr double ROOT_SIZE  = 8.0;
+    /// Deepest level. Columns and rows of deeper ones would not fit the
+    /// 64-bit keys.
+    static constexpr int    MAX_LEVEL  = 60;
+    /// Levels up to which single precision kernels are accurate enough
+    static constexpr int    FLOAT_LEVELS = 12;
+    /// Levels up to which double precision kernels are accurate enough and
+    /// views are located by their double position. Deeper tiles take the
+    /// fixed-point kernel and the fixed-point center of views.
+    static constexpr int    DOUBLE_LEVELS = 40;
+
+    /// Tile identifier
+    struct Key {
+        int     level = 0;
+        int64_t x     = 0;
+        int64_t y     = 0;
+
+        bool operator == (const Key& a_Other) const {
+            return level == a_Other.level && x == a_Other.x && y == a_Other.y;
+        }
+
+        /// Returns the key of the parent tile
+        Key getParent () const;
+    };
+
+    /// Key hash
+    struct KeyHash {
+        size_t operator () (const Key& a_Key) const;
+    };
+
+    /// Parameters tiles depend on
+    struct Params {
+        FractalType type     = FractalType::Mandelbrot;
+        double      coeff[2] = {0.0, 0.0};
+        size_t      maxIter  = 0;
+        unsigned    interior = 0;
+
+        bool operator == (const Params& a_Other) const;
+    };
+
+    /// A tile, TILE_SIZE x TILE_SIZE values, rows bottom-up
+    typedef std::vector<float> Tile;
+
+    /// Statistics
+    struct Stats {
+        /// Tiles in memory
+        size_t memory   = 0;
+        /// Tiles spilled to disk
+        size_t disk     = 0;
+        /// Tiles waiting to be computed or loaded
+        size_t pending  = 0;
+        /// Pixels of the last view served from tiles of the right level
+        double hitRate  = 0.0;
+    };
+
+    /// Creates the cache. An empty spill directory disables spilling. Zero
+    /// threads means half of the available ones.
+    TileCache (size_t a_Budget, const std::string& a_SpillDir, CpuIsa a_Isa, size_t a_Threads = 0);
+    /// Stops the workers and removes spilled tiles
+    ~TileCache ();
+
+    /// Sets the fractal parameters. Drops all the tiles if they differ.
+    void  setParams (const Params& a_Params);
+
+    /// Returns true if a view is shallow enough to be composited
+    static bool isCachable (const CpuKernelArgs& a_View);
+
+    /// Composites the field of a view (position, rotation, scale and size
+    /// are used, the center instead of the position beyond DOUBLE_LEVELS)
+    /// from the tiles and requests the missing ones. Pixels not covered by
+    /// any tile are set to zero.
+    void  composite (const CpuKernelArgs& a_View, float* a_Field);
+
+    /// Returns statistics
+    Stats getStats  () const;
+
+protected:
+
+    /// Cached tile
+    struct Entry {
+        std::shared_ptr<const Tile> tile;
+        std::list<Key>::iterator    lru;
+    };
+
+    /// Returns the level for a view
+    static int  getLevel     (const CpuKernelArgs& a_View);
+
+    /// Returns a tile from memory, null if not there. Marks it used. The
+    /// mutex must be held.
+    std::shared_ptr<const Tile> find (const Key& a_Key);
+    /// Inserts a tile, evicts tiles over the budget. The mutex must be held.
+    /// Evicted tiles to be spilled are returned in a_Evicted and marked as
+    /// being spilled.
+    void insert (const Key& a_Key, std::shared_ptr<const Tile> a_Tile,
+                 std::vector<std::pair<Key, std::shared_ptr<const Tile>>>* a_Evicted);
+
+    /// Computes a tile
+    void compute   (const Key& a_Key, const Params& a_Params, Tile* a_Tile) const;
+    /// Returns the spill file name of a tile
+    std::string getFileName (const Key& a_Key) const;
+    /// Returns the name of the file probing the spill directory, it differs
+    /// from all tile file names
+    std::string getProbeFileName () const;
+    /// Loads a spilled tile
+    bool load      (const Key& a_Key, Tile* a_Tile) const;
+    /// Spills a tile
+    bool save      (const Key& a_Key, const Tile& a_Tile) const;
+    /// Removes all spilled tiles. The mutex must be held.
+    void clearDisk ();
+
+    /// Worker thread proc
+    void workerProc ();
+
+    /// Maximum number of tiles in memory
+    size_t      m_MaxTiles;
+    /// Spill directory
+    std::string m_SpillDir;
+
+    /// Kernels
+    CpuKernel   m_FloatKernel;
+    CpuKernel   m_DoubleKernel;
+
+    /// Current parameters
+    Params      m_Params;
+    /// Incremented when the parameters change
+    uint64_t    m_Generation = 0;
+
+    /// Tiles in memory
+    std::unordered_map<Key, Entry, KeyHash> m_Tiles;
+    /// Tiles in memory, the most recently used first
+    std::list<Key> m_Lru;
+    /// Tiles spilled to disk
+    std::unordered_set<Key, KeyHash> m_OnDisk;
+    /// Tiles being spilled. Only one worker writes a spill file at a time.
+    std::unordered_set<Key, KeyHash> m_Spilling;
+
+    /// Tiles to compute or load, the most important first
+    std::deque<Key> m_Queue;
+    /// Tiles queued or in progress
+    std::unordered_set<Key, KeyHash> m_Pending;
+
+    /// Hit rate of the last view
+    double      m_HitRate = 0.0;
+
+    /// Guards all the above
+    mutable std::mutex      m_Mutex;
+    /// Signals the workers
+    std::condition_variable m_Signal;
+    /// Stop flag
+    bool        m_Stop = false;
+    /// Worker threads
+    std::vector<std::thread> m_Workers;
+};
+
+#endif // FRACTAL_TILE_CACHE_HH
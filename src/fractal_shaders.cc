@@ -0,0 +1,143 @@
+#include "fractal_shaders.hh"
+
+#include <utils/stringf.hh>
+
+#include <gl/utils.hh>
+
+#include <algorithm>
+
+// ============================================================================
+
+bool FractalVariant::operator == (const FractalVariant& a_Other) const {
+    return type      == a_Other.type &&
+           precision == a_Other.precision &&
+           exponent  == a_Other.exponent &&
+           interior  == a_Other.interior &&
+           unroll    == a_Other.unroll;
+}
+
+std::string FractalVariant::getName () const {
+    return stringf("%s_%s_d%d_i%u_u%d",
+        (type == FractalType::Julia) ? "julia" : "mandelbrot",
+        getFractalPrecisionName(precision),
+        exponent, interior, unroll
+        );
+}
+
+size_t FractalVariantHash::operator () (const FractalVariant& a_Variant) const {
+    size_t h = size_t(a_Variant.type);
+    h = h * 31 + size_t(a_Variant.precision);
+    h = h * 31 + size_t(a_Variant.exponent);
+    h = h * 31 + size_t(a_Variant.interior);
+    h = h * 31 + size_t(a_Variant.unroll);
+    return h;
+}
+
+// ============================================================================
+
+FractalShaderCache::FractalShaderCache (const std::string& a_VertexShader, size_t a_Capacity) :
+    m_VertexShader (a_VertexShader, GL_VERTEX_SHADER),
+    m_Capacity     (std::max(a_Capacity, size_t(1)))
+{
+    // Empty
+}
+
+// ============================================================================
+
+void FractalShaderCache::setSource (FractalPrecision a_Precision,
+                                    const std::string& a_FileName,
+                                    const GL::Shader::Defines& a_Defines)
+{
+    Source& source  = m_Sources[int(a_Precision)];
+    source.fileName = a_FileName;
+    source.defines  = a_Defines;
+
+    // Drop programs compiled from the previous source
+    for (auto itr = m_Lru.begin(); itr != m_Lru.end(); ) {
+        if (itr->first.precision == a_Precision) {
+            m_Programs.erase(itr->first);
+            itr = m_Lru.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+bool FractalShaderCache::hasSource (FractalPrecision a_Precision) const {
+    return m_Sources.count(int(a_Precision)) != 0;
+}
+
+// ============================================================================
+
+FractalVariant FractalShaderCache::normalize (const FractalVariant& a_Variant) {
+
+    FractalVariant variant = a_Variant;
+    variant.exponent = std::max(variant.exponent, int(FractalVariant::MIN_EXPONENT));
+    variant.exponent = std::min(variant.exponent, int(FractalVariant::MAX_EXPONENT));
+    variant.unroll   = std::max(variant.unroll, 1);
+
+    // The bulbs are those of the quadratic Mandelbrot set, the derivative
+    // check is implemented for the quadratic sets only
+    if (variant.type == FractalType::Julia || variant.exponent != 2) {
+        variant.interior &= ~unsigned(INTERIOR_BULBS);
+    }
+    if (variant.exponent != 2) {
+        variant.interior &= ~unsigned(INTERIOR_DERIVATIVE);
+    }
+
+    if (variant.precision == FractalPrecision::Perturbation) {
+        variant.exponent = 2;
+        variant.interior = 0;
+        variant.unroll   = 1;
+    }
+
+    return variant;
+}
+
+GL::ShaderProgram* FractalShaderCache::get (const FractalVariant& a_Variant) {
+
+    FractalVariant variant = normalize(a_Variant);
+
+    // Cached, mark it used
+    auto itr = m_Programs.find(variant);
+    if (itr != m_Programs.end()) {
+        m_Lru.splice(m_Lru.begin(), m_Lru, itr->second);
+        return itr->second->second.get();
+    }
+
+    // Compile
+    const Source& source = m_Sources.at(int(variant.precision));
+    GL::Shader::Defines defines = source.defines;
+
+    defines[(variant.type == FractalType::Julia) ? "JULIA" : "MANDELBROT"] = "1";
+    defines["EXPONENT"] = std::to_string(variant.exponent);
+    defines["INTERIOR"] = std::to_string(variant.interior);
+    defines["UNROLL"]   = std::to_string(variant.unroll);
+
+    std::string name = variant.getName();
+    GL::Shader fragmentShader (source.fileName, GL_FRAGMENT_SHADER, defines);
+
+    m_Lru.emplace_front(variant, std::unique_ptr<GL::ShaderProgram>(
+        new GL::ShaderProgram(m_VertexShader, fragmentShader, name)
+        ));
+    m_Programs[variant] = m_Lru.begin();
+    m_Compiles++;
+
+    // Evict the least recently used one
+    if (m_Lru.size() > m_Capacity) {
+        m_Programs.erase(m_Lru.back().first);
+        m_Lru.pop_back();
+    }
+
+    return m_Lru.front().second.get();
+}
+
+// ============================================================================
+
+size_t FractalShaderCache::getSize () const {
+    return m_Lru.size();
+}
+
+size_t FractalShaderCache::getCompiles () const {
+    return m_Compiles;
+}
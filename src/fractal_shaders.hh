@@ -0,0 +1,112 @@
+#ifndef FRACTAL_SHADERS_HH
+#define FRACTAL_SHADERS_HH
+
+#include <gl/shader.hh>
+
+#include "fractal/fractal.hh"
+#include "fractal/precision_ladder.hh"
+
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <string>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// Fractal shader variant. Everything in it is compiled into the program so
+/// the iteration loop does not branch on it.
+struct FractalVariant
+{
+    /// Lowest and highest supported exponents
+    static constexpr int MIN_EXPONENT = 2;
+    static constexpr int MAX_EXPONENT = 8;
+
+    FractalType      type      = FractalType::Mandelbrot;
+    FractalPrecision precision = FractalPrecision::Fp32;
+    /// Exponent of z^d + c
+    int              exponent  = 2;
+    /// Enabled interior checks, a mask of InteriorCheck flags
+    unsigned         interior  = INTERIOR_ALL;
+    /// Iterations per loop pass
+    int              unroll    = 1;
+
+    bool operator == (const FractalVariant& a_Other) const;
+
+    /// Returns a name of the variant, used as the shader program name
+    std::string getName () const;
+};
+
+/// Fractal shader variant hash
+struct FractalVariantHash {
+    size_t operator () (const FractalVariant& a_Variant) const;
+};
+
+// ============================================================================
+
+/// Compiles fractal shader variants on first use and keeps the most recently
+/// used ones. Each precision has a source file, the variant is injected to it
+/// as defines:
+///
+///  MANDELBROT / JULIA   the fractal type
+///  EXPONENT             the exponent
+///  INTERIOR             the interior check mask
+///  UNROLL               iterations per loop pass
+///
+/// Perturbation shaders support the quadratic sets only and have no interior
+/// checks, their variants are reduced to the type.
+class FractalShaderCache
+{
+public:
+
+    /// Creates the cache, a_VertexShader is linked to all the variants
+    FractalShaderCache (const std::string& a_VertexShader, size_t a_Capacity);
+
+    /// Sets the source of variants of a precision
+    void setSource (FractalPrecision a_Precision,
+                    const std::string& a_FileName,
+                    const GL::Shader::Defines& a_Defines = GL::Shader::Defines());
+    /// Returns true if variants of a precision have a source
+    bool hasSource (FractalPrecision a_Precision) const;
+
+    /// Returns the variant actually compiled for a requested one
+    static FractalVariant normalize (const FractalVariant& a_Variant);
+
+    /// Returns a program of a variant, compiles it if not cached. The least
+    /// recently used program is dropped when over the capacity.
+    GL::ShaderProgram* get (const FractalVariant& a_Variant);
+
+    /// Returns the number of cached programs
+    size_t getSize     () const;
+    /// Returns the number of programs compiled so far
+    size_t getCompiles () const;
+
+protected:
+
+    /// Source of variants of a precision
+    struct Source {
+        std::string         fileName;
+        GL::Shader::Defines defines;
+    };
+
+    /// Cached program
+    typedef std::pair<FractalVariant, std::unique_ptr<GL::ShaderProgram>> Entry;
+
+    /// Vertex shader
+    GL::Shader  m_VertexShader;
+    /// Maximum number of cached programs
+    size_t      m_Capacity;
+    /// Sources, indexed by precision
+    std::unordered_map<int, Source> m_Sources;
+
+    /// Cached programs, the most recently used first
+    std::list<Entry> m_Lru;
+    /// Cached programs by variant
+    std::unordered_map<FractalVariant, std::list<Entry>::iterator, FractalVariantHash> m_Programs;
+
+    /// Programs compiled so far
+    size_t      m_Compiles = 0;
+};
+
+#endif // FRACTAL_SHADERS_HH
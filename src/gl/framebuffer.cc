@@ -9,23 +9,63 @@ namespace GL {
 
 // ============================================================================
 
+/// Returns the pixel format and type of texture data for a texture format
+static void getPixelTransfer (GLenum a_Format, GLenum* a_DataFormat, GLenum* a_DataType) {
+
+    switch (a_Format)
+    {
+    case GL_R32F:
+        *a_DataFormat = GL_RED;
+        *a_DataType   = GL_FLOAT;
+        break;
+
+    case GL_RG16F:
+        *a_DataFormat = GL_RG;
+        *a_DataType   = GL_FLOAT;
+        break;
+
+    case GL_RGBA16F:
+        *a_DataFormat = GL_RGBA;
+        *a_DataType   = GL_FLOAT;
+        break;
+
+    case GL_RGBA32F:
+        *a_DataFormat = GL_RGBA;
+        *a_DataType   = GL_FLOAT;
+        break;
+
+    default:
+        *a_DataFormat = a_Format;
+        *a_DataType   = GL_UNSIGNED_BYTE;
+        break;
+    }
+}
+
+// ============================================================================
+
 Framebuffer::Framebuffer (size_t a_Width, size_t a_Height, GLenum a_Format, size_t a_Count, bool a_WithDepth) :
-    m_Width  (a_Width),
-    m_Height (a_Height),
-    m_Format (a_Format)
+    Framebuffer(a_Width, a_Height, std::vector<GLenum>(a_Count, a_Format), a_WithDepth)
+{
+}
+
+Framebuffer::Framebuffer (size_t a_Width, size_t a_Height, const std::vector<GLenum>& a_Formats, bool a_WithDepth) :
+    m_Width   (a_Width),
+    m_Height  (a_Height),
+    m_Formats (a_Formats)
 {
+    size_t count = a_Formats.size();
 
     // Check limit of maximum color attachments
 #ifdef GL_MAX_COLOR_ATTACHMENTS
-    if (a_Count > GL_MAX_COLOR_ATTACHMENTS) {
+    if (count > GL_MAX_COLOR_ATTACHMENTS) {
         throw std::runtime_error(
-            stringf("Too many color attachments requested (%d, max is %d)", a_Count, GL_MAX_COLOR_ATTACHMENTS)
+            stringf("Too many color attachments requested (%d, max is %d)", count, GL_MAX_COLOR_ATTACHMENTS)
         );
     }
 #else
-    if (a_Count > 1) {
+    if (count > 1) {
         throw std::runtime_error(
-            stringf("Too many color attachments requested (%d, max is 1)", a_Count)
+            stringf("Too many color attachments requested (%d, max is 1)", count)
         );
     }
 #endif    
@@ -37,12 +77,15 @@ Framebuffer::Framebuffer (size_t a_Width, size_t a_Height, GLenum a_Format, size
     GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer));
 
     // Create textures
-    m_Textures.resize(a_Count);
-    GL_CHECK(glGenTextures(a_Count, (GLuint*)m_Textures.data()));
+    m_Textures.resize(count);
+    GL_CHECK(glGenTextures(count, (GLuint*)m_Textures.data()));
 
     for (size_t i=0; i<m_Textures.size(); ++i) {
+        GLenum dataFormat, dataType;
+        getPixelTransfer(m_Formats[i], &dataFormat, &dataType);
+
         GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Textures[i]));        
-        GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, m_Format, a_Width, a_Height, 0, m_Format, GL_UNSIGNED_BYTE, 0));
+        GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, m_Formats[i], a_Width, a_Height, 0, dataFormat, dataType, 0));
         
         GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -111,8 +154,8 @@ size_t Framebuffer::getHeight() const {
     return m_Height;
 }
 
-GLenum Framebuffer::getFormat() const {
-    return m_Format;
+GLenum Framebuffer::getFormat(size_t a_Index) const {
+    return m_Formats[a_Index];
 }
 
 // ============================================================================
@@ -175,9 +218,13 @@ std::unique_ptr<uint8_t> Framebuffer::readPixels (size_t a_Index) {
     GL_CHECK(glFlush());
 
     // Sample size
+    GLenum dataFormat;
+    GLenum dataType;
+    getPixelTransfer(m_Formats[a_Index], &dataFormat, &dataType);
+
     size_t sampleSize;
 
-    switch (m_Format)
+    switch (dataFormat)
     {
     case GL_RED:    sampleSize = 1; break;
     case GL_RG:     sampleSize = 2; break;
@@ -188,6 +235,10 @@ std::unique_ptr<uint8_t> Framebuffer::readPixels (size_t a_Index) {
         throw std::runtime_error("Invalid framebuffer pixel format");
     }
 
+    if (dataType == GL_FLOAT) {
+        sampleSize *= sizeof(GLfloat);
+    }
+
     // Allocate
     size_t size = m_Width * m_Height * sampleSize;
     auto   data = std::unique_ptr<uint8_t>(new uint8_t[size]);
@@ -197,8 +248,8 @@ std::unique_ptr<uint8_t> Framebuffer::readPixels (size_t a_Index) {
     GL_CHECK(glReadBuffer(GL_COLOR_ATTACHMENT0 + a_Index));
 
     GL_CHECK(glPixelStorei(GL_PACK_ALIGNMENT, 1));
-    GL_CHECK(glReadPixels(0, 0, m_Width, m_Height, m_Format,
-                          GL_UNSIGNED_BYTE, data.get()));
+    GL_CHECK(glReadPixels(0, 0, m_Width, m_Height, dataFormat,
+                          dataType, data.get()));
     
     return data;
 }
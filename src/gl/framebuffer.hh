@@ -18,6 +18,8 @@ public:
 
     /// Creates the framebuffer
     Framebuffer (size_t a_Width, size_t a_Height, GLenum a_Format, size_t a_Count=1, bool a_WithDepth=true);
+    /// Creates the framebuffer with a format per texture
+    Framebuffer (size_t a_Width, size_t a_Height, const std::vector<GLenum>& a_Formats, bool a_WithDepth=true);
 
     /// Destructor
     virtual ~Framebuffer ();
@@ -30,15 +32,16 @@ public:
     size_t  getWidth    () const;
     /// Returns framebuffer height
     size_t  getHeight   () const;
-    /// Returns texture format
-    GLenum  getFormat   () const;
+    /// Returns format of a given texture
+    GLenum  getFormat   (size_t a_Index=0) const;
    
     /// Enables the framebuffer as the render target
     void    enable      ();
     /// Disables the framebuffer as the render target
     void    disable     ();
     
-    /// Retrieves pixel data. The framebuffer must be active
+    /// Retrieves pixel data. The framebuffer must be active. Floating point
+    /// formats are read as floats.
     std::unique_ptr<uint8_t> readPixels (size_t a_Index = 0);
     
 protected:
@@ -55,8 +58,8 @@ protected:
     size_t  m_Width  = 0;
     size_t  m_Height = 0;
     
-    /// Format
-    GLenum  m_Format = GL_RGBA;
+    /// Formats of textures
+    std::vector<GLenum> m_Formats;
 
     /// Is active
     bool    m_IsActive = false;
@@ -0,0 +1,412 @@
+#include "render_graph.hh"
+#include "utils.hh"
+
+#include <utils/stringf.hh>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <cmath>
+
+namespace GL {
+
+// ============================================================================
+
+/// Returns the approximate size of a texel of a texture format in bytes
+static size_t getTexelSize (GLenum a_Format) {
+
+    switch (a_Format)
+    {
+    case GL_RED:     return 1;
+    case GL_RG:      return 2;
+    case GL_RGB:     return 3;
+    case GL_RGBA32F: return 16;
+    default:         return 4;
+    }
+}
+
+// ============================================================================
+
+RenderGraph::Input::Input (const std::string& a_Target, const std::string& a_Sampler,
+                           GLenum a_Wrap, size_t a_Index) :
+    target  (a_Target),
+    index   (a_Index),
+    type    (GL_TEXTURE_2D),
+    texture (0),
+    sampler (a_Sampler),
+    wrap    (a_Wrap)
+{
+}
+
+RenderGraph::Input::Input (GLenum a_Type, GLuint a_Texture, const std::string& a_Sampler,
+                           GLenum a_Wrap) :
+    index   (0),
+    type    (a_Type),
+    texture (a_Texture),
+    sampler (a_Sampler),
+    wrap    (a_Wrap)
+{
+}
+
+// ============================================================================
+
+void RenderGraph::addTarget (const std::string& a_Name,
+                             const std::vector<GLenum>& a_Formats,
+                             double a_Scale)
+{
+    m_Targets[a_Name] = Target{a_Formats, a_Scale};
+    m_Dirty = true;
+}
+
+void RenderGraph::importTarget (const std::string& a_Name, Framebuffer* a_Framebuffer) {
+    m_Imported[a_Name] = a_Framebuffer;
+}
+
+void RenderGraph::addPass (const std::string& a_Name,
+                           ShaderProgram* a_Shader,
+                           const std::vector<Input>& a_Inputs,
+                           const std::string& a_Output,
+                           const std::function<void ()>& a_Draw)
+{
+    m_Passes.push_back(Pass{a_Name, a_Shader, a_Inputs, a_Output, a_Draw});
+    m_Dirty = true;
+}
+
+void RenderGraph::setOutput (const std::string& a_Name, bool a_IsOutput) {
+
+    bool isOutput = m_Outputs.count(a_Name) != 0;
+    if (isOutput == a_IsOutput) {
+        return;
+    }
+
+    if (a_IsOutput) {
+        m_Outputs.insert(a_Name);
+    }
+    else {
+        m_Outputs.erase(a_Name);
+    }
+
+    m_Dirty = true;
+}
+
+void RenderGraph::clear () {
+    m_Targets.clear();
+    m_Imported.clear();
+    m_Passes.clear();
+    m_Outputs.clear();
+    m_Live.clear();
+
+    m_Dirty = true;
+}
+
+void RenderGraph::resize (size_t a_Width, size_t a_Height) {
+
+    // Nothing is kept for a new size
+    m_Allocations.clear();
+    m_Allocated.clear();
+
+    m_Width  = a_Width;
+    m_Height = a_Height;
+    m_Dirty  = true;
+}
+
+// ============================================================================
+
+void RenderGraph::compile () {
+
+    // Find passes that contribute to the outputs, backwards from them
+    std::set<std::string> needed = m_Outputs;
+    std::vector<bool>     live (m_Passes.size(), false);
+
+    for (size_t i=m_Passes.size(); i-- > 0;) {
+        const Pass& pass = m_Passes[i];
+        if (!needed.count(pass.output)) {
+            continue;
+        }
+
+        if (!m_Targets.count(pass.output)) {
+            throw std::runtime_error(
+                stringf("Pass '%s' renders to an undeclared target '%s'",
+                        pass.name.c_str(), pass.output.c_str())
+            );
+        }
+
+        live[i] = true;
+        for (auto& input : pass.inputs) {
+            if (!input.target.empty()) {
+                needed.insert(input.target);
+            }
+        }
+    }
+
+    m_Live.clear();
+    for (size_t i=0; i<m_Passes.size(); ++i) {
+        if (live[i]) {
+            m_Live.push_back(i);
+        }
+    }
+
+    // Lifetimes of declared targets in live pass indices. A target is
+    // shareable when it is written first and not an output.
+    struct Lifetime {
+        size_t first;
+        size_t last;
+        bool   shareable;
+    };
+
+    std::map<std::string, Lifetime> lifetimes;
+    std::vector<std::string>        order;
+
+    auto use = [&](const std::string& a_Name, size_t a_Pass, bool a_Write) {
+        if (!m_Targets.count(a_Name)) {
+            return;
+        }
+
+        auto it = lifetimes.find(a_Name);
+        if (it == lifetimes.end()) {
+            bool shareable = a_Write && !m_Outputs.count(a_Name);
+            lifetimes[a_Name] = Lifetime{a_Pass, a_Pass, shareable};
+            order.push_back(a_Name);
+        }
+        else {
+            it->second.last = a_Pass;
+        }
+    };
+
+    for (size_t k=0; k<m_Live.size(); ++k) {
+        const Pass& pass = m_Passes[m_Live[k]];
+        for (auto& input : pass.inputs) {
+            use(input.target, k, false);
+        }
+        use(pass.output, k, true);
+    }
+
+    // Assign targets to framebuffers in the order of their first use. A
+    // shareable target takes a framebuffer whose targets are all dead.
+    struct Slot {
+        std::vector<std::string> names;
+        const Target*            target;
+        size_t                   last;
+        bool                     shareable;
+    };
+
+    std::vector<Slot> slots;
+    for (auto& name : order) {
+        const Lifetime& life   = lifetimes.at(name);
+        const Target&   target = m_Targets.at(name);
+
+        Slot* slot = nullptr;
+        if (life.shareable) {
+            for (auto& other : slots) {
+                if (other.shareable && other.last < life.first &&
+                    other.target->formats == target.formats &&
+                    other.target->scale   == target.scale)
+                {
+                    slot = &other;
+                    break;
+                }
+            }
+        }
+
+        if (slot == nullptr) {
+            slots.push_back(Slot{{}, &target, 0, life.shareable});
+            slot = &slots.back();
+        }
+
+        slot->names.push_back(name);
+        slot->last = life.last;
+    }
+
+    // Allocate. Framebuffers of the previous compilation are reused, the
+    // one that held the same target first as it has its content.
+    std::vector<Allocation>             pool     = std::move(m_Allocations);
+    std::map<std::string, Framebuffer*> previous = std::move(m_Allocated);
+
+    m_Allocations.clear();
+    m_Allocated.clear();
+
+    size_t bytes = 0;
+    for (auto& slot : slots) {
+        const auto& formats = slot.target->formats;
+        double      scale   = slot.target->scale;
+
+        size_t width  = std::max<size_t>(1, size_t(round(m_Width  * scale)));
+        size_t height = std::max<size_t>(1, size_t(round(m_Height * scale)));
+
+        auto matches = [&](const Allocation& a_Allocation) {
+            return a_Allocation.framebuffer &&
+                   a_Allocation.formats == formats &&
+                   a_Allocation.framebuffer->getWidth()  == width &&
+                   a_Allocation.framebuffer->getHeight() == height;
+        };
+
+        auto found = pool.end();
+        for (auto& name : slot.names) {
+            auto it = previous.find(name);
+            if (it == previous.end()) {
+                continue;
+            }
+
+            found = std::find_if(pool.begin(), pool.end(), [&](const Allocation& a_Allocation) {
+                return a_Allocation.framebuffer.get() == it->second && matches(a_Allocation);
+            });
+            if (found != pool.end()) {
+                break;
+            }
+        }
+
+        if (found == pool.end()) {
+            found = std::find_if(pool.begin(), pool.end(), matches);
+        }
+
+        Allocation allocation;
+        if (found != pool.end()) {
+            allocation = std::move(*found);
+        }
+        else {
+            allocation.framebuffer.reset(new Framebuffer(width, height, formats, false));
+            allocation.formats = formats;
+        }
+
+        for (auto& name : slot.names) {
+            m_Allocated[name] = allocation.framebuffer.get();
+        }
+
+        for (auto format : formats) {
+            bytes += width * height * getTexelSize(format);
+        }
+
+        m_Allocations.push_back(std::move(allocation));
+    }
+
+    logger->info("Render graph: {} of {} passes, {} targets in {} framebuffers ({:.1f} MB)",
+                 m_Live.size(), m_Passes.size(), order.size(), slots.size(),
+                 double(bytes) / (1024.0 * 1024.0));
+
+    m_Dirty = false;
+}
+
+// ============================================================================
+
+Framebuffer* RenderGraph::getFramebuffer (const std::string& a_Name) {
+
+    Framebuffer* framebuffer = getTarget(a_Name);
+    if (framebuffer == nullptr) {
+        throw std::runtime_error(
+            stringf("Render target '%s' is not available", a_Name.c_str())
+        );
+    }
+
+    return framebuffer;
+}
+
+Framebuffer* RenderGraph::getTarget (const std::string& a_Name) {
+
+    if (m_Dirty) {
+        compile();
+    }
+
+    auto imported = m_Imported.find(a_Name);
+    if (imported != m_Imported.end()) {
+        return imported->second;
+    }
+
+    auto allocated = m_Allocated.find(a_Name);
+    if (allocated != m_Allocated.end()) {
+        return allocated->second;
+    }
+
+    return nullptr;
+}
+
+// ============================================================================
+
+void RenderGraph::execute () {
+
+    if (m_Dirty) {
+        compile();
+    }
+
+    // The state is saved and restored once for the whole graph, not around
+    // every pass
+    GLint savedFramebuffer = 0;
+    GLint savedViewport[4];
+    GL_CHECK(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &savedFramebuffer));
+    GL_CHECK(glGetIntegerv(GL_VIEWPORT, savedViewport));
+
+    GLuint       program = 0;
+    Framebuffer* current = nullptr;
+
+    // Texture units and types bound
+    std::set<std::pair<size_t, GLenum>> bound;
+
+    for (size_t index : m_Live) {
+        const Pass& pass = m_Passes[index];
+
+        // Shader
+        if (pass.shader->get() != program) {
+            program = pass.shader->get();
+            GL_CHECK(glUseProgram(program));
+        }
+
+        // Inputs
+        for (size_t i=0; i<pass.inputs.size(); ++i) {
+            const Input& input = pass.inputs[i];
+
+            GLuint texture = input.texture;
+            if (!input.target.empty()) {
+                texture = getFramebuffer(input.target)->getTexture(input.index);
+            }
+
+            GL_CHECK(glActiveTexture(GL_TEXTURE0 + i));
+            GL_CHECK(glBindTexture(input.type, texture));
+            bound.insert(std::make_pair(i, input.type));
+
+            if (input.wrap != 0) {
+                GL_CHECK(glTexParameteri(input.type, GL_TEXTURE_WRAP_S, input.wrap));
+                GL_CHECK(glTexParameteri(input.type, GL_TEXTURE_WRAP_T, input.wrap));
+            }
+
+            if (!input.sampler.empty()) {
+                GL_CHECK(glUniform1i(pass.shader->getUniformLocation(input.sampler.c_str()), i));
+            }
+        }
+
+        // Target
+        Framebuffer* target = getFramebuffer(pass.output);
+        if (target != current) {
+            current = target;
+
+            GL_CHECK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target->get()));
+            GL_CHECK(glViewport(0, 0, target->getWidth(), target->getHeight()));
+
+            size_t count = m_Targets.at(pass.output).formats.size();
+            std::vector<GLenum> drawBuffers (count);
+            for (size_t i=0; i<count; ++i) {
+                drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+            }
+            GL_CHECK(glDrawBuffers(count, drawBuffers.data()));
+        }
+
+        // Render
+        pass.draw();
+    }
+
+    // Cleanup
+    for (auto& unit : bound) {
+        GL_CHECK(glActiveTexture(GL_TEXTURE0 + unit.first));
+        GL_CHECK(glBindTexture(unit.second, 0));
+    }
+    GL_CHECK(glActiveTexture(GL_TEXTURE0));
+
+    GL_CHECK(glUseProgram(0));
+
+    GL_CHECK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, savedFramebuffer));
+    GL_CHECK(glViewport(savedViewport[0], savedViewport[1],
+                        savedViewport[2], savedViewport[3]));
+}
+
+// ============================================================================
+
+}; // GL
@@ -0,0 +1,151 @@
+#ifndef GL_RENDER_GRAPH_HH
+#define GL_RENDER_GRAPH_HH
+
+#include "gl.hh"
+#include "framebuffer.hh"
+#include "shader.hh"
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <memory>
+#include <map>
+#include <set>
+
+#include <cstddef>
+
+namespace GL {
+
+// ============================================================================
+
+/// A graph of full screen render passes. Passes declare the textures they
+/// sample and the target they render to, the graph allocates the targets and
+/// binds them.
+///
+/// A target lives from the first pass that uses it to the last one. Targets
+/// with disjoint lifetimes and the same formats and size share a
+/// framebuffer. Passes that do not contribute to any output of the graph are
+/// skipped and targets used only by them are not allocated.
+///
+/// Outputs and targets read before they are written in a frame are never
+/// shared, they keep their content between frames.
+class RenderGraph
+{
+public:
+
+    /// A texture sampled by a pass, either a color attachment of a target
+    /// or any texture object
+    struct Input {
+
+        /// A color attachment of a target
+        Input (const std::string& a_Target, const std::string& a_Sampler = "",
+               GLenum a_Wrap = 0, size_t a_Index = 0);
+        /// A texture object
+        Input (GLenum a_Type, GLuint a_Texture, const std::string& a_Sampler = "",
+               GLenum a_Wrap = 0);
+
+        /// Target name, empty for a texture object
+        std::string target;
+        /// Color attachment of the target
+        size_t      index;
+        /// Texture type and object
+        GLenum      type;
+        GLuint      texture;
+        /// Sampler uniform name, none leaves the shader default
+        std::string sampler;
+        /// Wrap mode for both axes, zero leaves it as is
+        GLenum      wrap;
+    };
+
+    /// Declares a render target. The size is relative to the graph size.
+    void addTarget    (const std::string& a_Name,
+                       const std::vector<GLenum>& a_Formats,
+                       double a_Scale = 1.0);
+    /// Sets a framebuffer owned elsewhere as a target. It may be replaced
+    /// between frames.
+    void importTarget (const std::string& a_Name, Framebuffer* a_Framebuffer);
+
+    /// Adds a pass, passes run in the order they are added. The draw
+    /// function is called with the shader, the inputs (on texture units in
+    /// order) and the target bound. It sets the remaining uniforms and draws.
+    void addPass      (const std::string& a_Name,
+                       ShaderProgram* a_Shader,
+                       const std::vector<Input>& a_Inputs,
+                       const std::string& a_Output,
+                       const std::function<void ()>& a_Draw);
+
+    /// Removes all targets, passes and outputs. Framebuffers are kept until
+    /// the next compilation, targets declared again with the same name
+    /// get theirs back.
+    void clear        ();
+
+    /// Marks a target as an output of the graph or not
+    void setOutput    (const std::string& a_Name, bool a_IsOutput = true);
+    /// Sets the size of targets, they are allocated again
+    void resize       (size_t a_Width, size_t a_Height);
+
+    /// Runs the passes that contribute to the outputs. The framebuffer
+    /// binding and the viewport are restored.
+    void execute      ();
+
+    /// Returns the framebuffer of a target or nullptr when it is not
+    /// allocated
+    Framebuffer* getTarget (const std::string& a_Name);
+
+protected:
+
+    /// A declared target
+    struct Target {
+        std::vector<GLenum> formats;
+        double              scale;
+    };
+
+    /// A render pass
+    struct Pass {
+        std::string             name;
+        ShaderProgram*          shader;
+        std::vector<Input>      inputs;
+        std::string             output;
+        std::function<void ()>  draw;
+    };
+
+    /// A framebuffer with the formats it was created with
+    struct Allocation {
+        std::unique_ptr<Framebuffer> framebuffer;
+        std::vector<GLenum>          formats;
+    };
+
+    /// Selects live passes, assigns targets to framebuffers by their
+    /// lifetimes and allocates them
+    void compile ();
+
+    /// Returns the framebuffer of a target, throws if there is none
+    Framebuffer* getFramebuffer (const std::string& a_Name);
+
+    /// Declared targets
+    std::map<std::string, Target>       m_Targets;
+    /// Imported targets
+    std::map<std::string, Framebuffer*> m_Imported;
+    /// Passes
+    std::vector<Pass>                   m_Passes;
+    /// Output targets
+    std::set<std::string>               m_Outputs;
+
+    /// Allocated framebuffers
+    std::vector<Allocation>             m_Allocations;
+    /// Framebuffers of the allocated targets
+    std::map<std::string, Framebuffer*> m_Allocated;
+    /// Indices of passes that run
+    std::vector<size_t>                 m_Live;
+
+    /// Graph size
+    size_t  m_Width  = 0;
+    size_t  m_Height = 0;
+    /// Needs to be compiled
+    bool    m_Dirty  = true;
+};
+
+// ============================================================================
+
+}; // GL
+#endif // GL_RENDER_GRAPH_HH
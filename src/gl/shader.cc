@@ -20,7 +20,8 @@ Shader::Shader (const std::string a_Name, const std::string& a_Code, GLenum a_Ty
 {
     if (m_Type != GL_VERTEX_SHADER &&
         m_Type != GL_GEOMETRY_SHADER &&
-        m_Type != GL_FRAGMENT_SHADER)
+        m_Type != GL_FRAGMENT_SHADER &&
+        m_Type != GL_COMPUTE_SHADER)
     {
         throw std::runtime_error("Invalid shader type specified");
     }
@@ -280,6 +281,7 @@ void Shader::compile (const std::string& a_Code) {
     const std::string typeName = (m_Type == GL_VERTEX_SHADER)   ? "vertex"   :
                                  (m_Type == GL_GEOMETRY_SHADER) ? "geometry" :
                                  (m_Type == GL_FRAGMENT_SHADER) ? "fragment" :
+                                 (m_Type == GL_COMPUTE_SHADER)  ? "compute"  :
                                                                   "unknown";
 
     logger->info("Compiling {} shader '{}'...",
@@ -367,6 +369,20 @@ ShaderProgram::ShaderProgram (const Shader& a_VertexShader,
     link(a_VertexShader.get(), a_FragmentShader.get());
 }
 
+ShaderProgram::ShaderProgram (const Shader& a_ComputeShader,
+                              const std::string a_Name)
+{
+    // Determine shader program name if not given
+    if (a_Name.length() == 0) {
+        m_Name = a_ComputeShader.getName();
+    } else {
+        m_Name = a_Name;
+    }
+
+    // Link it
+    link(std::vector<GLuint>({a_ComputeShader.get()}));
+}
+
 ShaderProgram::~ShaderProgram () {
     
     // Delete the shader program
@@ -378,6 +394,10 @@ ShaderProgram::~ShaderProgram () {
 // ============================================================================
 
 void ShaderProgram::link (GLuint a_VertexShader, GLuint a_FragmentShader) {
+    link(std::vector<GLuint>({a_VertexShader, a_FragmentShader}));
+}
+
+void ShaderProgram::link (const std::vector<GLuint>& a_Shaders) {
 
     logger->info("Linking shader '{}'...",
         m_Name.c_str()
@@ -392,8 +412,9 @@ void ShaderProgram::link (GLuint a_VertexShader, GLuint a_FragmentShader) {
     }
     
     // Link program
-    GL_CHECK(glAttachShader(m_Program, a_VertexShader));
-    GL_CHECK(glAttachShader(m_Program, a_FragmentShader));
+    for (GLuint shader : a_Shaders) {
+        GL_CHECK(glAttachShader(m_Program, shader));
+    }
 
     GL_CHECK(glLinkProgram(m_Program));
     
@@ -4,6 +4,7 @@
 #include "gl.hh"
 
 #include <string>
+#include <vector>
 #include <map>
 
 namespace GL {
@@ -38,7 +39,7 @@ protected:
 
     /// Shader name
     std::string m_Name = "";
-    /// Shader type. GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+    /// Shader type. GL_VERTEX_SHADER, GL_FRAGMENT_SHADER or GL_COMPUTE_SHADER
     GLenum      m_Type = 0;
     /// Shader handle
     GLuint      m_Shader = GL_INVALID_VALUE;
@@ -69,6 +70,9 @@ public:
     ShaderProgram (const Shader& a_VertexShader,
                    const Shader& a_FragmentShader,
                    const std::string a_Name = std::string());
+    /// Constructor of a compute shader program
+    ShaderProgram (const Shader& a_ComputeShader,
+                   const std::string a_Name = std::string());
     /// Destructor
     virtual ~ShaderProgram    ();
 
@@ -97,6 +101,8 @@ protected:
 
     /// Link the shader program
     virtual void link (GLuint a_VertexShader, GLuint a_FragmentShader);    
+    /// Link the shader program from any shaders
+    virtual void link (const std::vector<GLuint>& a_Shaders);
 };
 
 // ============================================================================
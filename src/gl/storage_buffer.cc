@@ -0,0 +1,49 @@
+#include "storage_buffer.hh"
+#include "utils.hh"
+
+namespace GL {
+
+// ============================================================================
+
+StorageBuffer::StorageBuffer (size_t a_Size) :
+    m_Size (a_Size)
+{
+    GL_CHECK(glGenBuffers(1, &m_Buffer));
+    GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer));
+    GL_CHECK(glBufferData(GL_SHADER_STORAGE_BUFFER, a_Size, nullptr, GL_DYNAMIC_COPY));
+    GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+}
+
+StorageBuffer::~StorageBuffer () {
+    glDeleteBuffers(1, &m_Buffer);
+}
+
+// ============================================================================
+
+GLuint StorageBuffer::get () const {
+    return m_Buffer;
+}
+
+size_t StorageBuffer::getSize () const {
+    return m_Size;
+}
+
+// ============================================================================
+
+void StorageBuffer::bind (GLuint a_Index) {
+    GL_CHECK(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, a_Index, m_Buffer));
+}
+
+void StorageBuffer::fill (size_t a_Offset, size_t a_Count, GLuint a_Value) {
+
+    // Cleared on the GPU, no transfer from the client
+    GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer));
+    GL_CHECK(glClearBufferSubData(GL_SHADER_STORAGE_BUFFER, GL_R32UI,
+                                  a_Offset * sizeof(GLuint), a_Count * sizeof(GLuint),
+                                  GL_RED_INTEGER, GL_UNSIGNED_INT, &a_Value));
+    GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+}
+
+// ============================================================================
+
+}; // GL
@@ -0,0 +1,43 @@
+#ifndef GL_STORAGE_BUFFER_HH
+#define GL_STORAGE_BUFFER_HH
+
+#include "gl.hh"
+
+#include <cstddef>
+
+namespace GL {
+
+// ============================================================================
+
+/// Shader storage buffer object (OpenGL 4.3). The content is left
+/// uninitialized, it is meant to be written by shaders.
+class StorageBuffer
+{
+public:
+
+    // Constructor / desctructor
+    ~StorageBuffer ();
+     StorageBuffer (size_t a_Size);
+
+    /// Returns the buffer object
+    GLuint get     () const;
+    /// Returns the size in bytes
+    size_t getSize () const;
+
+    /// Binds the buffer to an indexed binding point
+    void   bind    (GLuint a_Index);
+    /// Sets a range of 32-bit words to a value
+    void   fill    (size_t a_Offset, size_t a_Count, GLuint a_Value);
+
+protected:
+
+    /// The buffer object
+    GLuint m_Buffer = 0;
+    /// Size in bytes
+    size_t m_Size   = 0;
+};
+
+// ============================================================================
+
+}; // GL
+#endif // GL_STORAGE_BUFFER_HH
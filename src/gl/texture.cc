@@ -20,9 +20,18 @@ Texture::Texture () {
 }
 
 Texture::Texture (size_t a_Width, size_t a_Height, GLenum a_Format) :
+    Texture(a_Width, a_Height, a_Format, a_Format, GL_UNSIGNED_BYTE)
+{
+    // Empty
+}
+
+Texture::Texture (size_t a_Width, size_t a_Height, GLenum a_InternalFormat,
+                  GLenum a_Format, GLenum a_Type) :
     m_Width  (a_Width),
     m_Height (a_Height),
-    m_Format (a_Format)
+    m_Format (a_Format),
+    m_InternalFormat (a_InternalFormat),
+    m_Type   (a_Type)
 {
     // Create the OpenGL object
     create();
@@ -32,8 +41,8 @@ Texture::Texture (size_t a_Width, size_t a_Height, GLenum a_Format) :
 
     // Allocate
     GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Texture));
-    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, a_Format, a_Width, a_Height, 0,
-                          a_Format, GL_UNSIGNED_BYTE, nullptr));
+    GL_CHECK(glTexImage2D(GL_TEXTURE_2D, 0, a_InternalFormat, a_Width, a_Height, 0,
+                          a_Format, a_Type, nullptr));
 
     // Setup default filtering
     GL_CHECK(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
@@ -70,6 +79,7 @@ Texture::Texture (const std::string a_FileName) {
     m_Width  = dx;
     m_Height = dy;
     m_Format = GL_RGBA;
+    m_InternalFormat = GL_RGBA;
         
     // Upload to OpenGL
     GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Texture));
@@ -124,6 +134,16 @@ void Texture::clear () {
                           m_Format, GL_UNSIGNED_BYTE, zeros.get()));
 }
 
+void Texture::upload (const void* a_Data) {
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_Texture));
+
+    GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    GL_CHECK(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_Width, m_Height,
+                             m_Format, m_Type, a_Data));
+
+    GL_CHECK(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
 // ============================================================================
 
 GLuint Texture::get () const {
@@ -17,6 +17,10 @@ public:
     Texture   ();
     /// Creates an empty texture with given resolution and format
     Texture   (size_t a_Width, size_t a_Height, GLenum a_Format);
+    /// Creates an empty texture with given resolution, internal format and
+    /// pixel data format and type
+    Texture   (size_t a_Width, size_t a_Height, GLenum a_InternalFormat,
+               GLenum a_Format, GLenum a_Type);
     /// Creates a texture from file
     Texture   (const std::string a_FileName);
     
@@ -44,6 +48,10 @@ public:
     /// Clears the texture
     virtual void clear ();
 
+    /// Uploads pixel data. The data must match the format and the type given
+    /// at texture creation.
+    virtual void upload (const void* a_Data);
+
 protected:
 
     /// Texture handle
@@ -58,6 +66,10 @@ protected:
     size_t  m_Height = 0;
     /// Format
     GLenum  m_Format = 0;
+    /// Internal format
+    GLenum  m_InternalFormat = 0;
+    /// Pixel data type
+    GLenum  m_Type = GL_UNSIGNED_BYTE;
 
     /// Bind target
     GLenum  m_BindTarget = 0;
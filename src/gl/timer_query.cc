@@ -0,0 +1,63 @@
+#include "timer_query.hh"
+#include "utils.hh"
+
+namespace GL {
+
+// ============================================================================
+
+TimerQuery::TimerQuery () {
+    GL_CHECK(glGenQueries(COUNT, m_Queries));
+}
+
+TimerQuery::~TimerQuery () {
+    glDeleteQueries(COUNT, m_Queries);
+}
+
+// ============================================================================
+
+void TimerQuery::begin () {
+
+    // All queries are in flight, drop the oldest result. Waits for it.
+    if (m_Pending == COUNT) {
+        GLuint64 time;
+        GL_CHECK(glGetQueryObjectui64v(m_Queries[m_Next], GL_QUERY_RESULT, &time));
+        m_Pending--;
+    }
+
+    GL_CHECK(glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_Next]));
+}
+
+void TimerQuery::end () {
+    GL_CHECK(glEndQuery(GL_TIME_ELAPSED));
+
+    m_Next = (m_Next + 1) % COUNT;
+    m_Pending++;
+}
+
+bool TimerQuery::getResult (double* a_Seconds) {
+
+    bool haveResult = false;
+
+    while (m_Pending) {
+        size_t index = (m_Next + COUNT - m_Pending) % COUNT;
+
+        GLint available = 0;
+        GL_CHECK(glGetQueryObjectiv(m_Queries[index], GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available) {
+            break;
+        }
+
+        GLuint64 time = 0;
+        GL_CHECK(glGetQueryObjectui64v(m_Queries[index], GL_QUERY_RESULT, &time));
+        m_Pending--;
+
+        *a_Seconds = double(time) * 1.0e-9;
+        haveResult = true;
+    }
+
+    return haveResult;
+}
+
+// ============================================================================
+
+}; // GL
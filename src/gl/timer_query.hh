@@ -0,0 +1,49 @@
+#ifndef GL_TIMER_QUERY_HH
+#define GL_TIMER_QUERY_HH
+
+#include "gl.hh"
+
+#include <cstddef>
+
+namespace GL {
+
+// ============================================================================
+
+/// Measures GPU time of a sequence of commands. Queries are kept in a ring
+/// so that their results are read a few frames late without stalling the
+/// pipeline.
+class TimerQuery
+{
+public:
+
+    // Constructor / desctructor
+    ~TimerQuery ();
+     TimerQuery ();
+
+    /// Starts a measurement. Queries can not be nested.
+    void begin ();
+    /// Ends the measurement
+    void end   ();
+
+    /// Returns the latest finished measurement in seconds. Returns false if
+    /// none has finished since the last call.
+    bool getResult (double* a_Seconds);
+
+protected:
+
+    /// Number of queries in flight
+    static const size_t COUNT = 4;
+
+    /// Query objects
+    GLuint m_Queries[COUNT];
+
+    /// Next query to begin
+    size_t m_Next    = 0;
+    /// Number of queries without a result read
+    size_t m_Pending = 0;
+};
+
+// ============================================================================
+
+}; // GL
+#endif // GL_TIMER_QUERY_HH
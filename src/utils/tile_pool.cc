@@ -0,0 +1,207 @@
+#include "tile_pool.hh"
+
+#include <algorithm>
+#include <chrono>
+
+// ============================================================================
+
+TilePool::TilePool (size_t a_Threads) {
+
+    if (a_Threads == 0) {
+        a_Threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_ThreadStats.resize(a_Threads);
+
+    for (size_t i=0; i<a_Threads; ++i) {
+        m_Queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+
+    for (size_t i=0; i<a_Threads; ++i) {
+        m_Threads.push_back(std::thread(&TilePool::worker, this, i));
+    }
+}
+
+TilePool::~TilePool () {
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+
+    m_Start.notify_all();
+
+    for (auto& thread : m_Threads) {
+        thread.join();
+    }
+}
+
+// ============================================================================
+
+size_t TilePool::getThreadCount () const {
+    return m_Threads.size();
+}
+
+const std::vector<TilePool::TileStats>& TilePool::getStats () const {
+    return m_Stats;
+}
+
+TilePool::Summary TilePool::getSummary () const {
+    Summary summary;
+
+    if (m_Stats.empty()) {
+        return summary;
+    }
+
+    std::vector<double> busy(m_Threads.size(), 0.0);
+
+    summary.minTime = m_Stats.front().time;
+    for (const auto& stats : m_Stats) {
+        summary.tiles++;
+        summary.stolen  += stats.stolen ? 1 : 0;
+        summary.minTime  = std::min(summary.minTime, stats.time);
+        summary.maxTime  = std::max(summary.maxTime, stats.time);
+        busy[stats.thread] += stats.time;
+    }
+
+    double total = 0.0;
+    for (double time : busy) {
+        total += time;
+        summary.maxBusy = std::max(summary.maxBusy, time);
+    }
+
+    if (summary.maxBusy > 0.0) {
+        summary.balance = (total / busy.size()) / summary.maxBusy;
+    }
+
+    return summary;
+}
+
+// ============================================================================
+
+void TilePool::run (size_t a_Width, size_t a_Height, size_t a_TileSize, const TileFunc& a_Func) {
+
+    // Make tiles
+    std::vector<Tile> tiles;
+    for (size_t y=0; y<a_Height; y+=a_TileSize) {
+        for (size_t x=0; x<a_Width; x+=a_TileSize) {
+            Tile tile;
+            tile.x0 = x;
+            tile.y0 = y;
+            tile.x1 = std::min(x + a_TileSize, a_Width);
+            tile.y1 = std::min(y + a_TileSize, a_Height);
+            tiles.push_back(tile);
+        }
+    }
+
+    m_Stats.clear();
+    if (tiles.empty()) {
+        return;
+    }
+
+    // Give each thread a contiguous run of tiles
+    size_t count = m_Queues.size();
+    for (size_t i=0; i<count; ++i) {
+        size_t beg = (tiles.size() *  i)      / count;
+        size_t end = (tiles.size() * (i + 1)) / count;
+
+        std::lock_guard<std::mutex> lock(m_Queues[i]->mutex);
+        m_Queues[i]->tiles.assign(tiles.begin() + beg, tiles.begin() + end);
+        m_ThreadStats[i].clear();
+    }
+
+    // Start the workers and wait
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Func    = a_Func;
+    m_Pending = count;
+    m_Generation++;
+    m_Start.notify_all();
+
+    m_Done.wait(lock, [&]{ return m_Pending == 0; });
+    m_Func = nullptr;
+
+    // Collect stats
+    for (const auto& stats : m_ThreadStats) {
+        m_Stats.insert(m_Stats.end(), stats.begin(), stats.end());
+    }
+}
+
+// ============================================================================
+
+bool TilePool::take (size_t a_Thread, Tile* a_Tile, bool* a_Stolen) {
+
+    // Own queue, most recently added first
+    {
+        Queue& queue = *m_Queues[a_Thread];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tiles.empty()) {
+            *a_Tile   = queue.tiles.back();
+            *a_Stolen = false;
+            queue.tiles.pop_back();
+            return true;
+        }
+    }
+
+    // Steal from the others, oldest first
+    size_t count = m_Queues.size();
+    for (size_t i=1; i<count; ++i) {
+        Queue& queue = *m_Queues[(a_Thread + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tiles.empty()) {
+            *a_Tile   = queue.tiles.front();
+            *a_Stolen = true;
+            queue.tiles.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TilePool::worker (size_t a_Thread) {
+
+    size_t generation = 0;
+
+    while (1) {
+
+        // Wait for a job
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Start.wait(lock, [&]{ return m_Stop || m_Generation != generation; });
+
+            if (m_Stop) {
+                break;
+            }
+
+            generation = m_Generation;
+        }
+
+        // Process tiles
+        auto& stats = m_ThreadStats[a_Thread];
+
+        Tile tile;
+        bool stolen;
+        while (take(a_Thread, &tile, &stolen)) {
+            auto t0 = std::chrono::steady_clock::now();
+            m_Func(tile, a_Thread);
+            auto t1 = std::chrono::steady_clock::now();
+
+            TileStats tileStats;
+            tileStats.tile   = tile;
+            tileStats.thread = a_Thread;
+            tileStats.time   = std::chrono::duration<double>(t1 - t0).count();
+            tileStats.stolen = stolen;
+            stats.push_back(tileStats);
+        }
+
+        // Done
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--m_Pending == 0) {
+                m_Done.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef TILE_POOL_HH
+#define TILE_POOL_HH
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+#include <cstddef>
+
+// ============================================================================
+
+/// A pool of worker threads processing rectangular tiles of an image.
+///
+/// Each worker has its own deque of tiles. It takes work from the back of
+/// its own deque and, once empty, steals from the front of the others. This
+/// keeps neighbouring tiles on the same thread while balancing load when the
+/// cost of tiles varies a lot.
+class TilePool
+{
+public:
+
+    /// A tile
+    struct Tile {
+        size_t x0, y0;
+        size_t x1, y1;
+    };
+
+    /// Tile timing
+    struct TileStats {
+        /// The tile
+        Tile   tile;
+        /// Thread that processed it
+        size_t thread;
+        /// Processing time [s]
+        double time;
+        /// Stolen from another thread
+        bool   stolen;
+    };
+
+    /// Summary of a run
+    struct Summary {
+        /// Tile count
+        size_t tiles    = 0;
+        /// Stolen tile count
+        size_t stolen   = 0;
+        /// Shortest and longest tile time [s]
+        double minTime  = 0.0;
+        double maxTime  = 0.0;
+        /// Busiest thread time [s]
+        double maxBusy  = 0.0;
+        /// Average thread busy time divided by the busiest one
+        double balance  = 1.0;
+    };
+
+    /// Function processing a tile
+    typedef std::function<void(const Tile& a_Tile, size_t a_Thread)> TileFunc;
+
+    /// Creates the pool. Zero threads means all available.
+    TilePool (size_t a_Threads = 0);
+    /// Stops the workers
+    ~TilePool ();
+
+    /// Returns the number of threads
+    size_t getThreadCount () const;
+
+    /// Splits an image into tiles and processes all of them. Blocks until
+    /// done.
+    void run (size_t a_Width, size_t a_Height, size_t a_TileSize, const TileFunc& a_Func);
+
+    /// Returns timing of tiles of the last run
+    const std::vector<TileStats>& getStats () const;
+    /// Returns summary of the last run
+    Summary getSummary () const;
+
+protected:
+
+    /// Per-thread work queue
+    struct Queue {
+        std::mutex       mutex;
+        std::deque<Tile> tiles;
+    };
+
+    /// Worker thread body
+    void worker (size_t a_Thread);
+    /// Takes a tile from own queue or steals one. Returns false if no work
+    /// is left.
+    bool take (size_t a_Thread, Tile* a_Tile, bool* a_Stolen);
+
+    /// Threads
+    std::vector<std::thread> m_Threads;
+    /// Queues
+    std::vector<std::unique_ptr<Queue>> m_Queues;
+
+    /// Job control
+    std::mutex              m_Mutex;
+    std::condition_variable m_Start;
+    std::condition_variable m_Done;
+    size_t   m_Generation = 0;
+    size_t   m_Pending    = 0;
+    bool     m_Stop       = false;
+    TileFunc m_Func;
+
+    /// Per-thread stats of the last run
+    std::vector<std::vector<TileStats>> m_ThreadStats;
+    /// All stats of the last run
+    std::vector<TileStats> m_Stats;
+};
+
+#endif // TILE_POOL_HH